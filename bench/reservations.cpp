@@ -0,0 +1,174 @@
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+#include "../vendor/sys/out.h"
+#include "../src/pantrymanager/pantryreservations.cpp"
+
+using namespace std;
+
+/*
+
+Stress driver for PantryReservations
+
+Not part of the app: build it on its own next to main.cpp, e.g.
+    g++ -std=c++17 -O2 -I. bench/reservations.cpp -o reservations -pthread
+    cl.exe /EHsc /O2 /std:c++17 /Fe:reservations.exe bench\reservations.cpp /I.
+
+Usage:
+    reservations [opsPerThread] [threads...]     (defaults: 200000 1 2 4 8)
+
+How it works:
+    - Runs in a scratch directory (system temp) with its own data/pantry.csv
+      of SLOTS rows, so the real ./data is never touched
+    - For every thread count:
+        - churn: each thread reserves 1 unit of a shared row and releases
+          it again, opsPerThread times; prints reserve+release pairs per second
+        - drain: every thread reserves 1 unit at a time from all rows until
+          nothing is left. The holds taken must add up to the stock exactly
+          (no unit given out twice, none lost) and every row must end at 0
+          available; then all holds are released and the stock checked again
+    - The last drain commits its holds and flushes once; pantry.csv must then
+      hold 0 of every row
+    - Exits 1 if any check fails
+
+*/
+
+// Global width variable for console output formatting
+int width = 80;
+
+static const int SLOTS = 16;                        // shared rows
+static const int STOCK = 2000;                      // units per row
+
+static int failures = 0;
+
+/*
+    Report a failed check
+*/
+static void check(bool ok, string what) {
+    if (ok) return;
+    out.coutln("FAIL: " + what);
+    failures++;
+}
+
+/*
+    Write the scratch pantry.csv
+*/
+static bool seed(filesystem::path dir) {
+    error_code ec;
+    filesystem::remove_all(dir, ec);
+    filesystem::create_directories(dir / "data", ec);
+    if (ec) return false;
+    filesystem::current_path(dir, ec);
+    if (ec) return false;
+    vector<vector<string>> rows;
+    for (int i = 0; i < SLOTS; i++) {
+        rows.push_back({ to_string(i + 1), "item" + to_string(i), to_string(STOCK), "piece" });
+    }
+    CSV csv("pantry.csv");
+    return csv.write(rows);
+}
+
+/*
+    Reserve/release pairs on shared rows, returns pairs per second
+*/
+static double churn(PantryReservations& stock, int threads, long long ops) {
+    vector<thread> pool;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&stock, t, ops]() {
+            unsigned int seed = 2463534242u + unsigned(t) * 7919u;
+            for (long long i = 0; i < ops; i++) {
+                seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;  // xorshift
+                PantryReservations::Hold hold = stock.reserve(int(seed % SLOTS), 1.0);
+                stock.release(hold);
+            }
+        });
+    }
+    for (size_t t = 0; t < pool.size(); t++) pool[t].join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return seconds > 0.0 ? double(ops) * threads / seconds : 0.0;
+}
+
+/*
+    Take every unit with `threads` threads and check none is given out twice
+*/
+static void drain(PantryReservations& stock, int threads, bool keep) {
+    vector<vector<PantryReservations::Hold>> taken(threads);
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&stock, &taken, t]() {
+            bool any = true;
+            while (any) {                           // sweep until every row is empty
+                any = false;
+                for (int s = 0; s < SLOTS; s++) {
+                    PantryReservations::Hold hold = stock.reserve((s + t) % SLOTS, 1.0);
+                    if (!hold.ok()) continue;
+                    taken[t].push_back(hold);
+                    any = true;
+                }
+            }
+        });
+    }
+    for (size_t t = 0; t < pool.size(); t++) pool[t].join();
+
+    long long holds = 0;
+    for (int t = 0; t < threads; t++) holds += (long long)taken[t].size();
+    check(holds == (long long)SLOTS * STOCK, to_string(threads) + " thread(s): took " + to_string(holds) + " of " + to_string(SLOTS * STOCK) + " units");
+    for (int s = 0; s < SLOTS; s++) {
+        check(stock.available(s) == 0.0, to_string(threads) + " thread(s): row " + to_string(s) + " left " + out.formatNumber(stock.available(s)));
+    }
+
+    for (int t = 0; t < threads; t++) {
+        for (size_t i = 0; i < taken[t].size(); i++) {
+            if (keep) stock.commit(taken[t][i]);
+            else stock.release(taken[t][i]);
+        }
+    }
+    for (int s = 0; s < SLOTS; s++) {
+        double expected = keep ? 0.0 : double(STOCK);
+        check(stock.available(s) == expected && stock.reserved(s) == 0.0, to_string(threads) + " thread(s): row " + to_string(s) + " not restored");
+    }
+}
+
+int main(int argc, char** argv) {
+    long long ops = argc > 1 ? atoll(argv[1]) : 200000;
+    vector<int> counts;
+    for (int i = 2; i < argc; i++) counts.push_back(max(1, atoi(argv[i])));
+    if (counts.empty()) counts = { 1, 2, 4, 8 };
+
+    filesystem::path dir = filesystem::temp_directory_path() / "chefpp-bench";
+    if (!seed(dir)) {
+        out.coutln("Error: Could not create " + dir.string());
+        return 1;
+    }
+    PantryReservations& stock = PantryReservations::shared();
+    stock.open();
+    check(stock.size() == size_t(SLOTS), "expected " + to_string(SLOTS) + " rows");
+
+    out.coutln("rows " + to_string(SLOTS) + " x " + to_string(STOCK) + ", " + to_string(ops) + " ops per thread, "
+        + to_string(thread::hardware_concurrency()) + " hardware thread(s)");
+    for (size_t i = 0; i < counts.size(); i++) {
+        double rate = churn(stock, counts[i], ops);
+        drain(stock, counts[i], i + 1 == counts.size());
+        out.coutln(to_string(counts[i]) + " thread(s): " + out.formatNumber(double(llround(rate))) + " reserve+release/s");
+    }
+
+    check(stock.flush(), "flush failed");
+    CSV csv("pantry.csv");
+    vector<vector<string>> written = csv.read();    // what the flush wrote
+    check(written.size() == size_t(SLOTS), "pantry.csv has " + to_string(written.size()) + " rows");
+    for (size_t i = 0; i < written.size(); i++) {
+        Pantry row = Pantry::fromCSVRow(written[i]);
+        check(row.quantity == 0.0, row.name + " still holds " + out.formatNumber(row.quantity));
+    }
+
+    error_code ec;
+    filesystem::current_path(dir.parent_path(), ec);
+    filesystem::remove_all(dir, ec);
+    out.coutln(failures == 0 ? "OK" : to_string(failures) + " check(s) failed");
+    return failures == 0 ? 0 : 1;
+}
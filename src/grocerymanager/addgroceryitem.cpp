@@ -46,7 +46,7 @@ private:
         out.hr();                                   // horizontal rule
         out.br();
         item.name = out.inputs("Enter item name: ");    // prompt for name
-        item.quantity = out.inputs("Enter quantity: "); // prompt for quantity
+        item.quantity = out.inputd("Enter quantity: "); // prompt for quantity
         item.unit = out.inputs("Enter unit (optional): ");  // prompt for unit
         out.br();
     }
@@ -58,7 +58,7 @@ private:
         out.clear();                                // clear screen
         out.coutln("+-----------------------------------------+");
         out.coutln("Item: " + item.name);           // display item name
-        out.coutln("Quantity: " + item.quantity + " " + item.unit);    // display quantity and unit
+        out.coutln("Quantity: " + out.formatNumber(item.quantity) + " " + item.unit);  // display quantity and unit
         out.coutln("+-----------------------------------------+");
         out.br();
         return out.inputYesNo("Add to grocery list? (y/n): ");     // prompt for confirmation
@@ -77,7 +77,7 @@ private:
         int c = out.inputi("Enter your choice: ");  // get user choice
         out.br();
         if (c == 1) { item.name = out.inputs("Name: "); }      // edit name
-        else if (c == 2) { item.quantity = out.inputs("Quantity: "); }     // edit quantity
+        else if (c == 2) { item.quantity = out.inputd("Quantity: "); }     // edit quantity
         else if (c == 3) { item.unit = out.inputs("Unit: "); }             // edit unit
     }
 
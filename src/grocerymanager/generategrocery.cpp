@@ -1,4 +1,5 @@
 #include "../../vendor/sys/out.h"
+#include "../../vendor/sys/units.h"
 #include "../../vendor/base/modal.h"
 #include "grocery.cpp"
 #include "../recipemanager/recipe.cpp"
@@ -27,6 +28,7 @@ using namespace std;
 
     Header classes:
     #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/units.h"
     #include "../../vendor/base/modal.h"
     #include "grocery.cpp"
     #include "../recipemanager/recipe.cpp"
@@ -90,43 +92,34 @@ private:
                     iname = out.trim(token);        // only name provided
                 }
             }
-            double need = 0.0; if (iamount != "") { try { need = stod(iamount); } catch (...) { need = 0.0; } }  // parse required amount
+            double need = 0.0; if (!out.parseNumber(iamount, need)) { need = 0.0; }    // parse required amount
+            double fallback = need > 0.0 ? need : 1.0;      // use amount or default to 1
             string unit = iunit;                    // store unit
 
-            vector<Pantry> pantry = Pantry::loadAll();      // load pantry items
             double have = 0.0; string haveUnit = ""; bool found = false;
-            string inameLower = out.toLowerCase(iname);     // normalize ingredient name
-            for (int k = 0; k < pantry.size(); k++) {
-                string pnamel = out.toLowerCase(pantry[k].name);    // normalize pantry name
-                if (pnamel == inameLower) {         // match found
-                    found = true;                   // mark as found
-                    haveUnit = pantry[k].unit;      // get pantry unit
-                    try { have = stod(pantry[k].quantity); } catch (...) { have = 0.0; }    // parse pantry quantity
-                    break;                          // exit loop
-                }
+            Pantry stock = Pantry::findByName(iname);       // indexed, case-insensitive lookup
+            if (stock.id > 0) {                     // match found
+                found = true;                       // mark as found
+                haveUnit = stock.unit;              // get pantry unit
+                have = stock.quantity;              // already numeric
             }
 
             if (!found) {                           // ingredient not in pantry
-                string qty = iamount == "" ? "1" : iamount;     // use amount or default to 1
-                GroceryItem gi(iname, qty, unit);   // create grocery item
+                GroceryItem gi(iname, fallback, unit);  // create grocery item
                 gi.save();                          // save to grocery list
             } else {
-                if (unit != "" && haveUnit != "" && unit != haveUnit) {     // unit mismatch
-                    string qty2 = iamount == "" ? "1" : iamount;    // use amount or default to 1
-                    GroceryItem gi2(iname, qty2, unit);     // create grocery item
-                    gi2.save();                     // save to grocery list (no conversion)
-                } else {
-                    double diff = need - have;      // calculate difference
-                    if (need == 0.0) {              // unknown amount
-                        if (have <= 0.0) {          // pantry has none
-                            GroceryItem gi3(iname, "1", unit);  // add 1 to list
-                            gi3.save();             // save to grocery list
-                        }
-                    } else if (diff > 0.0) {        // need more than have
-                        string addq = to_string(diff);      // convert difference to string
-                        GroceryItem gi4(iname, addq, unit); // create grocery item
-                        gi4.save();                 // save to grocery list
+                double diff = 0.0;
+                if (need == 0.0) {                  // unknown amount
+                    if (have <= 0.0) {              // pantry has none
+                        GroceryItem gi3(iname, 1.0, unit);  // add 1 to list
+                        gi3.save();                 // save to grocery list
                     }
+                } else if (!Units::shortfall(need, unit, have, haveUnit, iname, diff)) {   // units not convertible
+                    GroceryItem gi2(iname, fallback, unit); // create grocery item
+                    gi2.save();                     // save to grocery list (full amount)
+                } else if (diff > 0.0) {            // need more than have
+                    GroceryItem gi4(iname, diff, unit); // create grocery item (recipe unit)
+                    gi4.save();                     // save to grocery list
                 }
             }
         }
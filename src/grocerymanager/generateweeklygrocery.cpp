@@ -0,0 +1,75 @@
+#include "../../vendor/sys/out.h"
+#include "../../vendor/base/modal.h"
+#include "weeklygrocery.cpp"
+
+using namespace std;
+
+/*
+    GenerateWeeklyGroceryModal Class
+
+    This modal generates the grocery list for every meal planned in a week.
+
+    How it works:
+        - Prompts for a week label (same labels as the Meal Planner)
+        - Runs WeeklyGrocery::generate(), which totals the week's demand per
+          ingredient, subtracts pantry stock and writes the list in one batch
+        - Displays the items added
+        - Automatically returns to parent page after completion
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/base/modal.h"
+    #include "weeklygrocery.cpp"
+
+    GenerateWeeklyGroceryModal:
+        protected:
+            - schema()                  : Main modal logic (override from Modal)
+        public:
+            - GenerateWeeklyGroceryModal() : Constructor
+*/
+class GenerateWeeklyGroceryModal : public Modal {
+protected:
+    /*
+        Main modal schema - Generate grocery list for a week
+    */
+    void schema() override {
+        out.hr();                                   // horizontal rule
+        out.br();
+        string week = out.trim(out.inputs("Enter week label to shop for: "));  // prompt for week
+        if (week == "") { out.coutln("No week provided."); out.br(); return; }
+        out.br();
+
+        WeeklyGrocery::Result result = WeeklyGrocery::generate(week);
+        if (result.planned == 0) {                  // nothing planned
+            out.coutln("No meal plan found for week: " + week);
+            out.br();
+            return;                                 // exit modal
+        }
+        if (result.missingRecipes > 0) {            // plan points at deleted recipes
+            out.coutln("Warning: " + to_string(result.missingRecipes) + " planned recipe(s) no longer exist and were skipped.");
+        }
+        if (!result.saved) {                        // write failed
+            out.coutln("Error: Could not save grocery list.");
+            out.br();
+            return;                                 // exit modal
+        }
+        if (result.added.size() == 0) {             // pantry covers everything
+            out.coutln("Your pantry covers all " + to_string(result.ingredients) + " ingredient(s) for " + week + ".");
+            out.br();
+            return;                                 // exit modal
+        }
+        out.coutln("Added to grocery list for " + week + " (" + to_string(result.planned) + " meal(s)):");
+        out.br();
+        for (int i = 0; i < result.added.size(); i++) {
+            GroceryItem it = result.added[i];       // get current item
+            out.coutln("- " + it.name + " (" + out.formatNumber(it.quantity) + " " + it.unit + ")");
+        }
+        out.br();
+    }
+
+public:
+    /*
+        Constructor
+    */
+    GenerateWeeklyGroceryModal() : Modal() {}       // default constructor
+};
@@ -3,8 +3,10 @@
 
 #include "../../vendor/sys/out.h"
 #include "../../vendor/sys/csv.h"
+#include "../../vendor/sys/units.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 using namespace std;
 
@@ -24,19 +26,22 @@ using namespace std;
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/sys/csv.h"
+    #include "../../vendor/sys/units.h"
     
     GroceryItem:
         public:
             - id                        : Unique item id (1-based)
             - name                      : Item name
-            - quantity                  : Quantity value
+            - quantity                  : Quantity value (number, shortest form in CSV)
             - unit                      : Unit of measurement
             - toCSVRow()                : Convert item to CSV row format
             - fromCSVRow()              : Create GroceryItem from CSV row (static)
             - loadAll()                 : Load all items from CSV file (static)
             - findById()                : Find and return item by id (static)
             - findByNameAndUnit()       : Find item by name and unit (static)
-            - save()                    : Save item to CSV (merge duplicates by name+unit)
+            - findConvertible()         : Find same-name item with a convertible unit in loaded rows (static)
+            - save()                    : Save item to CSV (merge duplicates by name, converting units)
+            - saveAll()                 : Save many items with one read and one write (static)
             - deleteById()              : Delete item by id from CSV (static)
             - updateQuantityById()      : Update item quantity by id (static)
             - clearAll()                : Clear entire grocery list (static)
@@ -45,14 +50,14 @@ struct GroceryItem {
 public:
     int id;
     string name;
-    string quantity;
+    double quantity;
     string unit;
 
-    GroceryItem() { id = 0; }                       // default constructor
+    GroceryItem() { id = 0; quantity = 0.0; }       // default constructor
 
-    GroceryItem(string n, string q, string u) : name(n), quantity(q), unit(u) { id = 0; }  // constructor with name, quantity, unit
+    GroceryItem(string n, double q, string u) : name(n), quantity(q), unit(u) { id = 0; }  // constructor with name, quantity, unit
 
-    GroceryItem(int i, string n, string q, string u) : id(i), name(n), quantity(q), unit(u) {}  // constructor with all fields
+    GroceryItem(int i, string n, double q, string u) : id(i), name(n), quantity(q), unit(u) {}  // constructor with all fields
 
     /*
         Convert to CSV row
@@ -61,7 +66,7 @@ public:
         vector<string> row;
         row.push_back(to_string(id));               // add id to row
         row.push_back(name);                        // add name to row
-        row.push_back(quantity);                    // add quantity to row
+        row.push_back(out.formatNumber(quantity));  // add quantity to row (shortest form)
         row.push_back(unit);                        // add unit to row
         return row;                                 // return csv row
     }
@@ -76,7 +81,7 @@ public:
             try { pid = stoi(row[0]); } catch (...) { pid = 0; }   // parse id from string
             item.id = pid;                          // set id
             item.name = row[1];                     // set name
-            item.quantity = row[2];                 // set quantity
+            if (!out.parseNumber(row[2], item.quantity)) item.quantity = 0.0;  // parse quantity once
             item.unit = row[3];                     // set unit
         }
         return item;                                // return grocery item
@@ -128,19 +133,46 @@ public:
     }
 
     /*
-        Save item (merge duplicates by name+unit by adding quantities)
+        Find a same-name item whose unit the quantity converts into
+            - searches rows already loaded by the caller (no file read)
+            - exact unit match first, then any convertible unit
+            - converted receives the quantity in the found item's unit
+    */
+    static GroceryItem findConvertible(const vector<GroceryItem>& all, string gname, string gunit, double q, double& converted) {
+        string n1 = out.toLowerCase(out.trim(gname));   // normalize search name
+        string u1 = out.trim(gunit);                // normalize search unit
+        for (int i = 0; i < all.size(); i++) {      // exact unit first
+            if (n1 == out.toLowerCase(out.trim(all[i].name)) && u1 == out.trim(all[i].unit)) {
+                converted = q;
+                return all[i];                      // same unit
+            }
+        }
+        for (int i = 0; i < all.size(); i++) {
+            if (n1 != out.toLowerCase(out.trim(all[i].name))) continue;
+            if (Units::convert(q, gunit, all[i].unit, gname, converted)) {
+                return all[i];                      // convertible unit found
+            }
+        }
+        return GroceryItem();                       // return empty if not found
+    }
+
+    /*
+        Save item (merge duplicates by name and convertible unit by adding quantities)
+            - one read and one write of grocery.csv
     */
     void save() {
         CSV csv("grocery.csv");                     // create csv object
-        vector<vector<string>> data = csv.read();   // read existing data
+        vector<vector<string>> data = csv.read();   // single read
+        vector<GroceryItem> rows;
+        for (int i = 0; i < data.size(); i++) {
+            if (!data[i].empty()) { rows.push_back(fromCSVRow(data[i])); }     // parse rows once
+        }
 
-        GroceryItem existing = findByNameAndUnit(name, unit);   // check for duplicate
+        double converted = quantity;                // quantity in the existing item's unit
+        GroceryItem existing = findConvertible(rows, name, unit, quantity, converted);     // check for duplicate
         if (existing.id > 0) {                      // duplicate found
-            double a = 0.0; double b = 0.0;
-            try { a = stod(existing.quantity); } catch (...) { a = 0.0; }   // parse existing quantity
-            try { b = stod(quantity); } catch (...) { b = 0.0; }            // parse new quantity
-            double t = a + b;                       // add quantities
-            string ts = to_string(t);               // convert to string
+            double t = existing.quantity + converted;   // add quantities
+            string ts = out.formatNumber(t);        // shortest form
             for (int i = 0; i < data.size(); i++) {
                 if (data[i].size() >= 4) {          // valid row
                     int rid = 0; try { rid = stoi(data[i][0]); } catch (...) { rid = 0; }   // parse row id
@@ -151,7 +183,7 @@ public:
                 }
             }
             csv.write(data);                        // write updated data
-            out.coutln("Updated grocery item '" + name + "' to " + ts + " " + unit);
+            out.coutln("Updated grocery item '" + name + "' to " + ts + " " + existing.unit);
             out.br();
             return;                                 // exit method
         }
@@ -166,7 +198,7 @@ public:
         id = maxId + 1;                             // set new id
         data.push_back(toCSVRow());                 // add new row
         if (csv.write(data)) {                      // write to file
-            out.coutln("Added to grocery list: '" + name + "' (" + quantity + " " + unit + ")");
+            out.coutln("Added to grocery list: '" + name + "' (" + out.formatNumber(quantity) + " " + unit + ")");
         } else {
             out.coutln("Error: Could not save grocery item.");
         }
@@ -195,27 +227,66 @@ public:
     /*
         Update quantity by id
     */
-    static bool updateQuantityById(int gid, string newq) {
+    static bool updateQuantityById(int gid, double newq) {
         CSV csv("grocery.csv");                     // create csv object
         vector<vector<string>> data = csv.read();   // read existing data
         bool found = false;
         for (int i = 0; i < data.size(); i++) {
             if (data[i].size() >= 4) {              // valid row
                 int rid = 0; try { rid = stoi(data[i][0]); } catch (...) { rid = 0; }      // parse row id
-                if (rid == gid) { data[i][2] = newq; found = true; break; }     // update quantity
+                if (rid == gid) { data[i][2] = out.formatNumber(newq); found = true; break; }  // update quantity
             }
         }
         if (found) { csv.write(data); return true; }    // write updated data
         return false;                               // not found
     }
 
+    /*
+        Save many items with one read and one write
+            - same merge rules as save(): same name and a convertible
+              unit adds to the existing row (exact unit preferred)
+    */
+    static bool saveAll(vector<GroceryItem> items) {
+        if (items.empty()) return true;             // nothing to save
+        vector<GroceryItem> rows = loadAll();       // single read
+        unordered_map<string, vector<size_t>> byName;   // folded name -> rows
+        int maxId = 0;
+        for (size_t i = 0; i < rows.size(); i++) {
+            byName[out.toLowerCase(out.trim(rows[i].name))].push_back(i);
+            if (rows[i].id > maxId) { maxId = rows[i].id; }
+        }
+        for (size_t i = 0; i < items.size(); i++) {
+            vector<size_t>& same = byName[out.toLowerCase(out.trim(items[i].name))];
+            size_t target = rows.size(); double converted = items[i].quantity;
+            for (size_t j = 0; j < same.size() && target == rows.size(); j++) {     // exact unit first
+                if (out.trim(rows[same[j]].unit) == out.trim(items[i].unit)) { target = same[j]; }
+            }
+            for (size_t j = 0; j < same.size() && target == rows.size(); j++) {     // then convertible
+                if (Units::convert(items[i].quantity, items[i].unit, rows[same[j]].unit, items[i].name, converted)) { target = same[j]; }
+            }
+            if (target < rows.size()) {             // merge
+                rows[target].quantity += converted;
+            } else {                                // new row
+                GroceryItem row = items[i];
+                row.id = ++maxId;
+                same.push_back(rows.size());
+                rows.push_back(row);
+            }
+        }
+        vector<vector<string>> data;
+        data.reserve(rows.size());
+        for (size_t i = 0; i < rows.size(); i++) data.push_back(rows[i].toCSVRow());
+        CSV csv("grocery.csv");
+        return csv.write(data);                     // single write
+    }
+
     /*
         Clear entire grocery list
     */
-    static void clearAll() {
+    static bool clearAll() {
         CSV csv("grocery.csv");                     // create csv object
         vector<vector<string>> empty;               // create empty vector
-        csv.write(empty);                           // write empty data (clear file)
+        return csv.write(empty);                    // single truncating write (clear file)
     }
 };
 
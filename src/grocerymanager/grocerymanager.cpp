@@ -5,6 +5,8 @@
 #include "viewgrocery.cpp"
 #include "syncgrocery.cpp"
 #include "generategrocery.cpp"
+#include "generateweeklygrocery.cpp"
+#include "viewshortfall.cpp"
 
 using namespace std;
 
@@ -31,6 +33,8 @@ using namespace std;
     #include "viewgrocery.cpp"              // ViewGroceryPage (page)
     #include "syncgrocery.cpp"              // SyncGroceryWithPantryModal (modal)
     #include "generategrocery.cpp"          // GenerateGroceryFromRecipeModal (modal)
+    #include "generateweeklygrocery.cpp"    // GenerateWeeklyGroceryModal (modal)
+    #include "viewshortfall.cpp"            // ViewShortfallPage (page)
 
     Options:
         - "Generate from Recipe"  : Opens GenerateGroceryFromRecipeModal (select recipe → compare pantry → add missing → return)
@@ -38,6 +42,8 @@ using namespace std;
         - "Remove Item"           : Opens RemoveGroceryItemModal (list → select → confirm → delete → return)
         - "View Grocery List"     : Opens ViewGroceryPage (displays all items)
         - "Sync with Pantry"      : Opens SyncGroceryWithPantryModal (list → confirm → add to pantry → clear list → return)
+        - "Generate for Week"     : Opens GenerateWeeklyGroceryModal (week → total demand → subtract pantry → add missing → return)
+        - "What to Buy"           : Opens ViewShortfallPage (live shortfall for every planned meal)
 */
 class GroceryManagerPage : public Page {
 public:
@@ -53,24 +59,25 @@ public:
 
         this->options = {
             Options("Generate from Recipe", []() {  // option 1: generate from recipe
-                GenerateGroceryFromRecipeModal gen; // create modal instance
-                gen.init();                         // open modal
+                Navigator::shared().open(new GenerateGroceryFromRecipeModal()); // open modal
             }),
             Options("Add Item", []() {              // option 2: add item
-                AddGroceryItemModal add;            // create modal instance
-                add.init();                         // open modal
+                Navigator::shared().open(new AddGroceryItemModal()); // open modal
             }),
             Options("Remove Item", []() {           // option 3: remove item
-                RemoveGroceryItemModal rem;         // create modal instance
-                rem.init();                         // open modal
+                Navigator::shared().open(new RemoveGroceryItemModal()); // open modal
             }),
             Options("View Grocery List", []() {     // option 4: view list
-                ViewGroceryPage view;               // create page instance
-                view.init();                        // open page
+                Navigator::shared().open(new ViewGroceryPage()); // open page
             }),
             Options("Sync with Pantry", []() {      // option 5: sync to pantry
-                SyncGroceryWithPantryModal sync;    // create modal instance
-                sync.init();                        // open modal
+                Navigator::shared().open(new SyncGroceryWithPantryModal()); // open modal
+            }),
+            Options("Generate for Week", []() {     // option 6: whole meal-plan week
+                Navigator::shared().open(new GenerateWeeklyGroceryModal()); // open modal
+            }),
+            Options("What to Buy", []() {           // option 7: live shortfall
+                Navigator::shared().open(new ViewShortfallPage()); // open page
             })
         };
     }
@@ -83,4 +90,11 @@ protected:
               the header and the options list.
     */
     void schema() override {}                       // empty schema (menu only)
+
+    /*
+        Menu only - the frame never changes, so it is drawn once
+    */
+    unsigned long long dataVersion() override {
+        return 1;
+    }
 };
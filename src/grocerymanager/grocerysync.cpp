@@ -0,0 +1,100 @@
+#ifndef GROCERYSYNC_H                           // for no dup def
+#define GROCERYSYNC_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/units.h"
+#include "grocery.cpp"
+#include "../pantrymanager/pantrybatch.cpp"
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+    GrocerySync Struct
+
+    Moves a grocery list into the pantry in one linear pass: the list is
+    collapsed by ingredient and unit, merged into the pantry with a single
+    write, and then cleared with a single write.
+
+    How it works:
+        - Names are interned (case-folded name -> small int) so each grocery
+          line is keyed by (name id, normalized unit) without repeated
+          string folding; "Flour/Cups" and "flour/cup" share one key.
+        - Lines with the same key are summed in a hash table, so duplicate
+          grocery lines become one pantry delta (first spelling kept).
+        - The collapsed lines go through one PantryBatch: pantry rows are
+          hash-joined by name, quantities converted to the stored unit,
+          and pantry.csv is written once (its history is appended in the
+          same step; lots are untouched because grocery lines are undated).
+        - The grocery list is cleared only after the pantry write
+          succeeded, with one truncating write. If the pantry write fails
+          nothing is cleared, so the sync can simply be retried.
+        - O(G + P) for G grocery lines and P pantry rows.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/units.h"
+    #include "grocery.cpp"
+    #include "../pantrymanager/pantrybatch.cpp"
+
+    GrocerySync:
+        public:
+            - Result                    : Outcome of one sync
+            - run(items)                : Merge items into the pantry and clear the list (static)
+*/
+struct GrocerySync {
+public:
+    struct Result {
+        bool pantrySaved = false;                   // pantry.csv written
+        bool groceryCleared = false;                // grocery.csv cleared
+        int lines = 0;                              // grocery lines read
+        int merged = 0;                             // distinct (name, unit) lines
+        int created = 0;                            // new pantry rows
+        int updated = 0;                            // existing pantry rows updated
+        int unconverted = 0;                        // unit mismatches added as-is
+    };
+
+    /*
+        Merge grocery items into the pantry, then clear the grocery list
+    */
+    static Result run(const vector<GroceryItem>& items) {
+        Result result;
+        result.lines = int(items.size());
+
+        unordered_map<string, int> names;           // interned folded names
+        unordered_map<string, size_t> slots;        // (name id, unit) -> collapsed line
+        vector<GroceryItem> collapsed;
+        names.reserve(items.size());
+        slots.reserve(items.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            string folded = out.toLowerCase(out.trim(items[i].name));
+            auto name = names.emplace(folded, int(names.size())).first;    // intern
+            string key = to_string(name->second) + '\x1f' + Units::normalize(items[i].unit);
+            auto slot = slots.find(key);
+            if (slot == slots.end()) {              // first line for this key
+                slots.emplace(key, collapsed.size());
+                collapsed.push_back(items[i]);
+            } else {
+                collapsed[slot->second].quantity += items[i].quantity;  // same unit: plain sum
+            }
+        }
+        result.merged = int(collapsed.size());
+
+        PantryBatch batch;                          // one pantry transaction
+        for (size_t i = 0; i < collapsed.size(); i++) {
+            batch.add(collapsed[i].name, collapsed[i].quantity, collapsed[i].unit);
+        }
+        result.pantrySaved = batch.commit();        // write 1: pantry.csv
+        result.created = batch.created;
+        result.updated = batch.updated;
+        result.unconverted = batch.unconverted;
+        if (!result.pantrySaved) return result;     // keep grocery list for a retry
+
+        result.groceryCleared = GroceryItem::clearAll();    // write 2: grocery.csv
+        return result;
+    }
+};
+
+#endif                                              // GROCERYSYNC_H
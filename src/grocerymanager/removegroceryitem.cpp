@@ -46,7 +46,7 @@ protected:
         out.br();
         for (int i = 0; i < items.size(); i++) {
             GroceryItem it = items[i];              // get current item
-            out.coutln(to_string(i + 1) + ". " + it.name + " - " + it.quantity + " " + it.unit + " (ID: " + to_string(it.id) + ")");  // display item
+            out.coutln(to_string(i + 1) + ". " + it.name + " - " + out.formatNumber(it.quantity) + " " + it.unit + " (ID: " + to_string(it.id) + ")");  // display item
         }
         out.br();
         int id = out.inputi("Enter item ID to remove: ");   // prompt for id
@@ -0,0 +1,197 @@
+#ifndef SHORTFALLTRACKER_H                      // for no dup def
+#define SHORTFALLTRACKER_H
+
+#include "../../vendor/sys/out.h"
+#include "../recipemanager/recipe.cpp"
+#include "../pantrymanager/pantry.cpp"
+#include "../mealplanner/mealplan.cpp"
+#include "../mealplanner/demandmatrix.cpp"
+#include <vector>
+#include <string>
+#include <set>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+    ShortfallTracker Struct
+
+    Keeps "what to buy for everything planned" current in memory, so a
+    pantry edit or one changed meal-plan day does not regenerate the list.
+
+    How it works:
+        - Rows are the ingredient columns of DemandMatrix (name + canonical
+          unit). For each row it keeps demand (all planned meals) and supply
+          (the pantry row with that name, in the same canonical unit).
+        - rebuild() reads the meal plan and the pantry once and sums every
+          planned meal's CSR row into demand.
+        - It subscribes to Pantry::listeners() and MealPlan::listeners():
+            - a planned meal added/removed adds/subtracts its recipe's CSR
+              row (only the ingredients of that recipe are touched)
+            - a pantry row change replaces that ingredient's old supply
+        - Each touched row is re-checked and kept in the `open` set when
+          demand exceeds supply, so current() never scans the catalog.
+          An update costs O(ingredients of the changed recipe or row).
+        - A recipe edit changes the matrix columns, so the tracker goes
+          stale when Recipe::tableVersion() moves and rebuilds on the next
+          query; events received while stale are ignored.
+        - Ingredients without an amount are not tracked (see DemandMatrix).
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../recipemanager/recipe.cpp"
+    #include "../pantrymanager/pantry.cpp"
+    #include "../mealplanner/mealplan.cpp"
+    #include "../mealplanner/demandmatrix.cpp"
+
+    ShortfallTracker:
+        public:
+            - Line                      : One ingredient still to buy
+            - current()                 : Ingredients where demand exceeds supply
+            - meals()                   : Planned meals counted in demand
+            - shared()                  : Process-wide tracker (static)
+        private:
+            - demand / supply           : Per-column totals (canonical units)
+            - stocked                   : Pantry id -> (column, amount) it supplies
+            - open                      : Columns with demand > supply
+            - fresh()                   : Built for the current recipe table
+            - rebuild()                 : Full recomputation
+            - applyMeal(recipeId, sign) : Add or remove one planned meal
+            - applyStock(row, removed)  : Replace one pantry row's supply
+            - refresh(column)           : Re-check one row
+*/
+struct ShortfallTracker {
+public:
+    struct Line {
+        string name;                                // ingredient
+        string unit;                                // canonical unit
+        double demand = 0.0;                        // needed by planned meals
+        double supply = 0.0;                        // in the pantry
+        double missing = 0.0;                       // demand - supply
+    };
+
+    /*
+        Ingredients still to buy, in column order
+    */
+    vector<Line> current() {
+        if (!fresh()) rebuild();
+        DemandMatrix& matrix = DemandMatrix::shared();
+        vector<Line> lines;
+        lines.reserve(open.size());
+        for (int col : open) {
+            Line line;
+            line.name = matrix.columns[col].name;
+            line.unit = matrix.columns[col].unit;
+            line.demand = demand[col];
+            line.supply = supply[col];
+            line.missing = demand[col] - supply[col];
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    /*
+        Planned meals counted in demand
+    */
+    int meals() {
+        if (!fresh()) rebuild();
+        return planned;
+    }
+
+    /*
+        Process-wide tracker (subscribes on first use)
+    */
+    static ShortfallTracker& shared() {
+        static ShortfallTracker tracker;
+        return tracker;
+    }
+
+private:
+    static constexpr double EPSILON = 1e-9;         // ignore rounding residue
+
+    vector<double> demand;                          // column -> planned amount
+    vector<double> supply;                          // column -> pantry amount
+    unordered_map<int, pair<int, double>> stocked;  // pantry id -> (column, amount)
+    set<int> open;                                  // columns with demand > supply
+    int planned = 0;                                // meals counted
+    bool built = false;                             // totals mirror the files
+    unsigned long long version = 0;                 // recipe table version at build
+
+    ShortfallTracker() {
+        MealPlan::listeners().push_back([this](const MealPlan& entry, bool removed) {
+            if (fresh()) applyMeal(entry.recipeId, removed ? -1.0 : 1.0);
+        });
+        Pantry::listeners().push_back([this](const Pantry& row, bool removed) {
+            if (fresh()) applyStock(row, removed);
+        });
+    }
+
+    bool fresh() {
+        return built && version == Recipe::tableVersion();
+    }
+
+    /*
+        Recompute every total from the meal plan and the pantry
+    */
+    void rebuild() {
+        DemandMatrix& matrix = DemandMatrix::shared();  // rebuilt if recipes changed
+        size_t n = matrix.columns.size();
+        demand.assign(n, 0.0);
+        supply.assign(n, 0.0);
+        stocked.clear();
+        open.clear();
+        planned = 0;
+        built = true;
+        version = Recipe::tableVersion();
+
+        vector<MealPlan> plan = MealPlan::loadAll();    // one read
+        for (size_t i = 0; i < plan.size(); i++) applyMeal(plan[i].recipeId, 1.0);
+        vector<Pantry> rows = Pantry::loadAll();    // cached store
+        for (size_t i = 0; i < rows.size(); i++) applyStock(rows[i], false);
+    }
+
+    /*
+        Add (sign 1) or remove (sign -1) one planned meal
+    */
+    void applyMeal(int recipeId, double sign) {
+        DemandMatrix& matrix = DemandMatrix::shared();
+        auto row = matrix.rowOf.find(recipeId);
+        if (row == matrix.rowOf.end()) return;      // recipe no longer exists
+        planned += sign > 0 ? 1 : -1;
+        size_t r = size_t(row->second);
+        for (size_t k = matrix.rowPtr[r]; k < matrix.rowPtr[r + 1]; k++) {
+            demand[matrix.colIdx[k]] += sign * matrix.values[k];
+            refresh(matrix.colIdx[k]);
+        }
+    }
+
+    /*
+        Replace the supply of one pantry row
+    */
+    void applyStock(const Pantry& row, bool removed) {
+        auto old = stocked.find(row.id);
+        if (old != stocked.end()) {                 // take back the previous amount
+            supply[old->second.first] -= old->second.second;
+            refresh(old->second.first);
+            stocked.erase(old);
+        }
+        if (removed) return;
+
+        double amount = 0.0;
+        int col = DemandMatrix::shared().columnFor(row.name, row.quantity, row.unit, amount);
+        if (col < 0) return;                        // no recipe uses it
+        supply[col] += amount;
+        stocked[row.id] = { col, amount };
+        refresh(col);
+    }
+
+    /*
+        Keep one column in or out of the open set
+    */
+    void refresh(int col) {
+        if (demand[col] - supply[col] > EPSILON) open.insert(col);
+        else open.erase(col);
+    }
+};
+
+#endif                                              // SHORTFALLTRACKER_H
@@ -1,7 +1,7 @@
 #include "../../vendor/sys/out.h"
 #include "../../vendor/base/modal.h"
 #include "grocery.cpp"
-#include "../pantrymanager/pantry.cpp"
+#include "grocerysync.cpp"
 
 using namespace std;
 
@@ -15,15 +15,16 @@ using namespace std;
         - Loads all grocery items
         - Displays what will be synced to pantry
         - Asks for confirmation (y/n)
-        - If confirmed, adds each item to pantry (duplicates are merged)
-        - Clears the entire grocery list after sync
+        - If confirmed, hands the already-loaded items to GrocerySync, which
+          merges them into the pantry with one write and then clears the
+          grocery list with one write
         - Automatically returns to parent page after completion
 
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/base/modal.h"
     #include "grocery.cpp"
-    #include "../pantrymanager/pantry.cpp"
+    #include "grocerysync.cpp"
 
     SyncGroceryWithPantryModal:
         protected:
@@ -49,18 +50,27 @@ protected:
         out.br();
         for (int i = 0; i < items.size(); i++) {
             GroceryItem it = items[i];              // get current item
-            out.coutln("- " + it.name + " (" + it.quantity + " " + it.unit + ")");     // display item
+            out.coutln("- " + it.name + " (" + out.formatNumber(it.quantity) + " " + it.unit + ")");     // display item
         }
         out.br();
         bool ok = out.inputYesNo("Proceed to sync and clear grocery list? (y/n): ");   // prompt for confirmation
         if (!ok) { out.coutln("Sync cancelled."); out.br(); return; }   // user cancelled
         
-        for (int i = 0; i < items.size(); i++) {
-            GroceryItem it = items[i];              // get current item
-            Pantry p(it.name, it.quantity, it.unit);    // create pantry item
-            p.save();                               // save to pantry (merge if duplicate)
+        GrocerySync::Result result = GrocerySync::run(items);   // single pass, two writes
+        if (!result.pantrySaved) {                  // pantry write failed
+            out.coutln("Error: Could not update pantry. Grocery list kept.");
+            out.br();
+            return;                                 // exit modal
+        }
+        out.coutln("Pantry updated: " + to_string(result.created) + " added, " + to_string(result.updated) + " merged.");
+        if (result.unconverted > 0) {               // unit mismatches
+            out.coutln("Warning: " + to_string(result.unconverted) + " item(s) had units that could not be converted and were added unchanged.");
+        }
+        if (!result.groceryCleared) {               // grocery write failed
+            out.coutln("Error: Could not clear grocery list. Remove synced items before syncing again.");
+            out.br();
+            return;                                 // exit modal
         }
-        GroceryItem::clearAll();                    // clear grocery list
         out.coutln("Sync complete. Grocery list cleared.");
         out.br();
     }
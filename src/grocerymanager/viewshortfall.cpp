@@ -0,0 +1,72 @@
+#include "../../vendor/sys/out.h"
+#include "../../vendor/base/page.h"
+#include "shortfalltracker.cpp"
+
+using namespace std;
+
+/*
+    ViewShortfallPage Class
+
+    This page shows what still has to be bought for every planned meal,
+    given what is in the pantry right now.
+
+    How it works:
+        - Reads ShortfallTracker::shared().current(); the tracker is built on
+          first use and afterwards follows pantry and meal-plan changes
+          incrementally, so reopening this page does not recompute the plan
+        - Displays each missing ingredient with needed / in pantry amounts
+          in canonical units (g, ml, piece)
+        - Provides a back option to return to grocery manager
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/base/page.h"
+    #include "shortfalltracker.cpp"
+
+    ViewShortfallPage:
+        protected:
+            - schema()                  : Display the current shortfall (override from Page)
+        public:
+            - ViewShortfallPage()       : Constructor
+*/
+class ViewShortfallPage : public Page {
+protected:
+    /*
+        Display the current shortfall
+    */
+    void schema() override {
+        out.hr();                                   // horizontal rule
+        out.br();
+        ShortfallTracker& tracker = ShortfallTracker::shared();
+        vector<ShortfallTracker::Line> lines = tracker.current();
+        if (tracker.meals() == 0) {                 // nothing planned
+            out.coutln("No planned meals.");
+            out.br();
+            return;                                 // exit schema
+        }
+        if (lines.size() == 0) {                    // pantry covers the plan
+            out.coutln("Your pantry covers all " + to_string(tracker.meals()) + " planned meal(s).");
+            out.br();
+            return;                                 // exit schema
+        }
+        out.coutln("To buy for " + to_string(tracker.meals()) + " planned meal(s) (" + to_string(lines.size()) + " item(s)):");
+        out.br();
+        for (int i = 0; i < lines.size(); i++) {
+            ShortfallTracker::Line l = lines[i];    // get current line
+            string unit = l.unit == "" ? "" : " " + l.unit;
+            out.coutln(to_string(i + 1) + ". " + l.name + " - " + out.formatNumber(l.missing) + unit + " (need " + out.formatNumber(l.demand) + ", have " + out.formatNumber(l.supply) + ")");
+        }
+        out.br();
+    }
+public:
+    /*
+        Constructor
+            - Set header and back behavior
+    */
+    ViewShortfallPage() : Page() {
+        this->header = "What to Buy";               // set page header
+        this->showheader = true;                    // enable header display
+        this->useExitInsteadOfBack = false;         // use back instead of exit
+        this->options = {};                         // no additional options
+    }
+};
@@ -0,0 +1,186 @@
+#ifndef WEEKLYGROCERY_H                         // for no dup def
+#define WEEKLYGROCERY_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/units.h"
+#include "grocery.cpp"
+#include "../recipemanager/recipe.cpp"
+#include "../pantrymanager/pantry.cpp"
+#include "../mealplanner/mealplan.cpp"
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+    WeeklyGrocery Struct
+
+    Builds the grocery list for a whole meal-plan week at once, instead of
+    running the one-recipe generator for every planned meal.
+
+    How it works:
+        - generate(week) reads the week with MealPlan::findByWeek() and all
+          planned recipes with one Recipe::findByIds() read. A recipe
+          planned several times counts once per meal.
+        - aggregate() reduces every ingredient of every planned meal into
+          one Demand per ingredient name, converting amounts into the
+          first unit seen (Units). Amounts that cannot be converted get
+          their own Demand for that name and unit.
+        - shortfall() hash-joins the demand with the pantry (one pass over
+          the pantry rows to build a folded-name table, then one lookup per
+          demand) and keeps what is still missing, in the demand unit.
+          Stock used by one demand is not counted again for another
+          demand of the same ingredient.
+        - The missing items are written with GroceryItem::saveAll(): one
+          read and one write of grocery.csv.
+        - Rules match the single-recipe generator: an ingredient missing
+          from the pantry is bought in full (1 if its amount is unknown),
+          an unknown amount with empty stock buys 1, and unconvertible
+          units buy the full amount.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/units.h"
+    #include "grocery.cpp"
+    #include "../recipemanager/recipe.cpp"
+    #include "../pantrymanager/pantry.cpp"
+    #include "../mealplanner/mealplan.cpp"
+
+    WeeklyGrocery:
+        public:
+            - Demand                    : Total need for one ingredient and unit
+            - Result                    : Outcome of one generation
+            - aggregate(meals)          : Reduce planned recipes to demand (static)
+            - shortfall(demand)         : Demand minus pantry stock (static)
+            - generate(week)            : Plan -> demand -> shortfall -> grocery.csv (static)
+*/
+struct WeeklyGrocery {
+public:
+    struct Demand {
+        string name;                                // first spelling seen
+        string unit;                                // unit totals are kept in
+        double quantity = 0.0;                      // known total (0 if only unknown amounts)
+        bool unknownAmount = false;                 // some meal gave no amount
+    };
+
+    struct Result {
+        int planned = 0;                            // meal-plan entries for the week
+        int missingRecipes = 0;                     // planned ids not in recipes.csv
+        int ingredients = 0;                        // distinct demands
+        vector<GroceryItem> added;                  // items written to the list
+        bool saved = false;                         // grocery.csv written
+    };
+
+    /*
+        Reduce the ingredients of every meal into one Demand per ingredient
+    */
+    static vector<Demand> aggregate(const vector<Recipe>& meals) {
+        vector<Demand> demand;
+        unordered_map<string, vector<size_t>> byName;   // folded name -> demand slots
+        for (size_t m = 0; m < meals.size(); m++) {
+            for (size_t i = 0; i < meals[m].ingredients.size(); i++) {
+                string name = ""; string amountText = ""; string unit = "";
+                Recipe::splitIngredient(meals[m].ingredients[i], name, amountText, unit);
+                if (name == "") continue;           // empty token
+                double amount = 0.0;
+                if (!out.parseNumber(amountText, amount)) amount = 0.0;
+
+                vector<size_t>& slots = byName[out.toLowerCase(name)];
+                size_t target = demand.size(); double converted = amount;
+                for (size_t j = 0; j < slots.size() && target == demand.size(); j++) {
+                    Demand& d = demand[slots[j]];
+                    if (amount == 0.0) { target = slots[j]; break; }    // unknown amount: any slot
+                    bool unitless = out.trim(unit).empty() || out.trim(d.unit).empty();
+                    if (unitless) { converted = amount; target = slots[j]; }
+                    else if (Units::convert(amount, unit, d.unit, name, converted)) { target = slots[j]; }
+                }
+                if (target == demand.size()) {      // first time for this name and unit
+                    Demand d;
+                    d.name = name; d.unit = unit;
+                    slots.push_back(demand.size());
+                    demand.push_back(d);
+                    converted = amount;
+                }
+                if (amount == 0.0) { demand[target].unknownAmount = true; }
+                else {
+                    demand[target].quantity += converted;
+                    if (demand[target].unit == "") { demand[target].unit = unit; }  // adopt first real unit
+                }
+            }
+        }
+        return demand;
+    }
+
+    /*
+        What still has to be bought after using pantry stock
+    */
+    static vector<GroceryItem> shortfall(const vector<Demand>& demand) {
+        vector<Pantry> rows = Pantry::loadAll();    // cached after the first read
+        unordered_map<string, Pantry> stock;        // build side: folded name -> row
+        stock.reserve(rows.size());
+        for (size_t i = 0; i < rows.size(); i++) {
+            stock.emplace(out.toLowerCase(rows[i].name), rows[i]);
+        }
+
+        vector<GroceryItem> buy;
+        for (size_t i = 0; i < demand.size(); i++) {    // probe side
+            const Demand& d = demand[i];
+            double fallback = d.quantity > 0.0 ? d.quantity : 1.0;
+            auto hit = stock.find(out.toLowerCase(d.name));
+            if (hit == stock.end()) {               // not in pantry
+                buy.push_back(GroceryItem(d.name, fallback, d.unit));
+                continue;
+            }
+            Pantry& have = hit->second;
+            if (d.quantity == 0.0) {                // only unknown amounts
+                if (have.quantity <= 0.0) buy.push_back(GroceryItem(d.name, 1.0, d.unit));
+                continue;
+            }
+            double missing = 0.0;
+            if (!Units::shortfall(d.quantity, d.unit, have.quantity, have.unit, d.name, missing)) {
+                buy.push_back(GroceryItem(d.name, d.quantity, d.unit));     // units not convertible
+                continue;
+            }
+            if (missing > 0.0) buy.push_back(GroceryItem(d.name, missing, d.unit));
+
+            double used = d.quantity - missing;     // stock taken, in demand unit
+            double usedInStock = used;
+            bool unitless = out.trim(d.unit).empty() || out.trim(have.unit).empty();
+            if (!unitless) Units::convert(used, d.unit, have.unit, d.name, usedInStock);
+            have.quantity = have.quantity > usedInStock ? have.quantity - usedInStock : 0.0;
+        }
+        return buy;
+    }
+
+    /*
+        Generate the grocery list for a meal-plan week
+    */
+    static Result generate(string week) {
+        Result result;
+        vector<MealPlan> plan = MealPlan::findByWeek(week);     // one read
+        result.planned = int(plan.size());
+        if (plan.empty()) return result;
+
+        vector<int> ids;
+        for (size_t i = 0; i < plan.size(); i++) ids.push_back(plan[i].recipeId);
+        vector<Recipe> found = Recipe::findByIds(ids);  // one read
+        unordered_map<int, size_t> byId;
+        for (size_t i = 0; i < found.size(); i++) byId[found[i].id] = i;
+
+        vector<Recipe> meals;                       // one entry per planned meal
+        for (size_t i = 0; i < plan.size(); i++) {
+            auto hit = byId.find(plan[i].recipeId);
+            if (hit == byId.end()) { result.missingRecipes++; continue; }
+            meals.push_back(found[hit->second]);
+        }
+
+        vector<Demand> demand = aggregate(meals);
+        result.ingredients = int(demand.size());
+        result.added = shortfall(demand);
+        result.saved = GroceryItem::saveAll(result.added);      // one write
+        return result;
+    }
+};
+
+#endif                                              // WEEKLYGROCERY_H
@@ -29,12 +29,11 @@ protected:
         out.br();
     }
 
-public:
+    unsigned long long dataVersion() override {
+        return 1;                                   // logo only: keep the frame
+    }
 
-    RecipeManagerPage recipeManager;
-    PantryManagerPage pantryManager;
-    GroceryManagerPage groceryManager;
-    MealPlannerPage mealPlanner;
+public:
 
     IndexPage() : Page() {
         // Set to show "Exit" instead of "Back"
@@ -44,16 +43,16 @@ public:
         // Initialize the parent class options vector
         options = {
             Options("Recipe Manager", [this]() {
-                recipeManager.init();
+                Navigator::shared().open(new RecipeManagerPage());
             }),
             Options("Pantry Inventory Manager", [this]() {
-                pantryManager.init();
+                Navigator::shared().open(new PantryManagerPage());
             }),
             Options("Meal Planner", [this]() {
-                mealPlanner.init();
+                Navigator::shared().open(new MealPlannerPage());
             }),
             Options("Grocery List Manager", [this]() {
-                groceryManager.init();
+                Navigator::shared().open(new GroceryManagerPage());
             })
         };
     }
@@ -0,0 +1,141 @@
+#include "../../vendor/sys/out.h"
+#include "../../vendor/base/modal.h"
+#include "kitassembly.cpp"
+#include "../pantrymanager/pantryreservations.cpp"
+
+using namespace std;
+
+/*
+    AssembleKitsModal Class
+
+    This modal builds the pick list for a batch of meal kits.
+
+    How it works:
+        - Prompts for a manifest file in ./data ("recipeId,servings,count"
+          per line); a blank answer lets the user type order lines instead,
+          ending with an empty line
+        - Runs KitAssembly::assembleFile() or KitAssembly::assemble(), which
+          scale each recipe to the ordered servings and reduce all lines in
+          parallel
+        - Lists the total of every ingredient to pick in canonical units
+        - Optionally draws the picks from the pantry through
+          PantryReservations: every pick is reserved first and only when all
+          of them fit are they committed and flushed in one pantry write;
+          otherwise every hold is released and the short items are listed
+        - Automatically returns to parent page after completion
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/base/modal.h"
+    #include "kitassembly.cpp"
+    #include "../pantrymanager/pantryreservations.cpp"
+
+    AssembleKitsModal:
+        private:
+            - promptOrders()            : Reads order lines typed by the user
+            - drawFromPantry(picks)     : Reserve and commit all picks, or none
+        protected:
+            - schema()                  : Main modal logic (override from Modal)
+        public:
+            - AssembleKitsModal()       : Constructor
+*/
+class AssembleKitsModal : public Modal {
+private:
+    /*
+        Read typed order lines until an empty line
+    */
+    vector<KitAssembly::Order> promptOrders() {
+        vector<KitAssembly::Order> orders;
+        out.coutln("Enter order lines as recipeId,servings,count (empty line to finish):");
+        while (true) {
+            string line = out.trim(out.inputs("> "));
+            if (line == "") break;
+            KitAssembly::Order order;
+            if (!KitAssembly::parseLine(line, order)) {
+                out.coutln("Invalid line. Use recipeId,servings,count (servings 0 = as written).");
+                continue;
+            }
+            orders.push_back(order);
+        }
+        return orders;
+    }
+
+    /*
+        Reserve every pick; commit them all or release them all
+    */
+    void drawFromPantry(const vector<KitAssembly::Pick>& picks) {
+        PantryReservations& stock = PantryReservations::shared();
+        stock.open();                               // snapshot pantry counters
+        vector<PantryReservations::Hold> holds;
+        vector<string> shortItems;
+        for (size_t i = 0; i < picks.size(); i++) {
+            PantryReservations::Hold hold = stock.reserve(picks[i].name, picks[i].amount, picks[i].unit);
+            if (hold.ok()) holds.push_back(hold);
+            else shortItems.push_back(picks[i].name);
+        }
+
+        if (!shortItems.empty()) {                  // all or nothing
+            for (size_t i = 0; i < holds.size(); i++) stock.release(holds[i]);
+            out.coutln("Not enough in the pantry for " + to_string(shortItems.size()) + " item(s); nothing was drawn:");
+            for (size_t i = 0; i < shortItems.size(); i++) out.coutln("- " + shortItems[i]);
+            out.br();
+            return;
+        }
+        for (size_t i = 0; i < holds.size(); i++) stock.commit(holds[i]);
+        if (stock.flush()) {
+            out.coutln("Drew " + to_string(picks.size()) + " ingredient(s) from the pantry.");
+            if (!stock.lotsSaved) out.coutln("Warning: Could not update expiry lots.");
+        } else {
+            out.coutln("Error: Could not update the pantry; the draw will be written next time.");
+        }
+        out.br();
+    }
+
+protected:
+    /*
+        Main modal schema - Build a pick list
+    */
+    void schema() override {
+        out.subheader("Assemble Meal Kits");
+        string file = out.trim(out.inputs("Manifest file in data/ (blank to type orders): "));
+        KitAssembly::Result result;
+        if (file == "") {
+            result = KitAssembly::assemble(promptOrders());
+        } else if (!KitAssembly::assembleFile(file, result)) {
+            out.coutln("Error: Could not open data/" + file + ".");
+            out.br();
+            return;                                 // exit modal
+        }
+        out.br();
+
+        if (result.lines == 0) {                    // nothing usable
+            out.coutln("No order lines to assemble.");
+            if (result.skipped > 0) out.coutln("Skipped " + to_string(result.skipped) + " invalid line(s).");
+            out.br();
+            return;                                 // exit modal
+        }
+
+        out.coutln("Pick list for " + to_string(result.kits) + " kit(s) from " + to_string(result.lines) + " order line(s):");
+        out.br();
+        for (size_t i = 0; i < result.picks.size(); i++) {
+            const KitAssembly::Pick& p = result.picks[i];
+            string unit = p.unit == "" ? "" : " " + p.unit;
+            out.coutln(to_string(i + 1) + ". " + p.name + " - " + out.formatNumber(p.amount) + unit);
+        }
+        out.br();
+        if (result.skipped > 0) out.coutln("Skipped " + to_string(result.skipped) + " invalid line(s) or unknown recipe(s).");
+        if (result.unscaled > 0) out.coutln(to_string(result.unscaled) + " line(s) use recipes without base servings; amounts used as written.");
+        if (result.skipped > 0 || result.unscaled > 0) out.br();
+
+        if (!result.picks.empty() && out.inputYesNo("Draw these picks from the pantry? (y/n): ")) {
+            out.br();
+            drawFromPantry(result.picks);
+        }
+    }
+
+public:
+    /*
+        Constructor
+    */
+    AssembleKitsModal() : Modal() {}                // default constructor
+};
@@ -0,0 +1,85 @@
+#include "../../vendor/sys/out.h"
+#include "../../vendor/base/modal.h"
+#include "bulkplanner.cpp"
+
+using namespace std;
+
+/*
+    BulkGenerateModal Class
+
+    This modal plans a run of consecutive weeks (e.g. a quarter) at once.
+
+    How it works:
+        - Prompts for the first ISO week, the number of weeks and whether
+          to clear existing plans for those weeks
+        - Runs BulkPlanner::generate(), which plans the weeks concurrently
+          and saves them in one batched write
+        - Displays a one-line summary per week
+        - Automatically returns to parent page after completion
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/base/modal.h"
+    #include "bulkplanner.cpp"
+
+    BulkGenerateModal:
+        protected:
+            - schema()                  : Main modal logic (override from Modal)
+        public:
+            - BulkGenerateModal()       : Constructor
+*/
+class BulkGenerateModal : public Modal {
+protected:
+    /*
+        Main modal schema - Plan many weeks
+    */
+    void schema() override {
+        out.subheader("Bulk Generate Meal Plans");
+        string first = out.trim(out.inputs("First week (ISO, e.g. 2025-W14): "));
+        int y = 0, w = 0;
+        if (!Dates::parseWeek(first, y, w)) {       // ranges need calendar weeks
+            out.coutln("Invalid week. Use the form YYYY-Www.");
+            out.br();
+            return;                                 // exit modal
+        }
+        int count = out.inputi("Number of weeks (1-52): ");
+        if (count < 1 || count > 52) {
+            out.coutln("Number of weeks must be between 1 and 52.");
+            out.br();
+            return;                                 // exit modal
+        }
+        bool wipe = out.inputYesNo("Clear existing plans for these weeks? (y/n): ");
+        out.br();
+
+        BulkPlanner::Result result = BulkPlanner::generate(BulkPlanner::consecutiveWeeks(first, count), wipe);
+        if (result.entries.empty()) {               // nothing could be planned
+            out.coutln("No recipes with ingredient amounts available to plan with.");
+            out.coutln("Existing plans were left unchanged.");
+            out.br();
+            return;                                 // exit modal
+        }
+        if (!result.saved) {                        // write failed
+            out.coutln("Error: Could not save meal plans.");
+            out.br();
+            return;                                 // exit modal
+        }
+
+        out.coutln("Planned " + to_string(result.weeks.size()) + " week(s), " + to_string(result.entries.size()) + " meal(s):");
+        out.br();
+        size_t e = 0;
+        for (size_t i = 0; i < result.weeks.size(); i++) {
+            string line = "";
+            for (; e < result.entries.size() && result.entries[e].week == result.weeks[i]; e++) {
+                line += (line == "" ? "" : ", ") + result.entries[e].recipeName();
+            }
+            out.coutln("- " + result.weeks[i] + ": " + line);
+        }
+        out.br();
+    }
+
+public:
+    /*
+        Constructor
+    */
+    BulkGenerateModal() : Modal() {}                // default constructor
+};
@@ -0,0 +1,118 @@
+#ifndef BULKPLANNER_H                           // for no dup def
+#define BULKPLANNER_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/dates.h"
+#include "../../vendor/sys/threadpool.h"
+#include "../recipemanager/recipe.cpp"
+#include "../pantrymanager/pantry.cpp"
+#include "mealplan.cpp"
+#include "demandmatrix.cpp"
+#include "mealoptimizer.cpp"
+#include <vector>
+#include <string>
+#include <future>
+
+using namespace std;
+
+/*
+    BulkPlanner Struct
+
+    Generates meal plans for many weeks at once (e.g. a quarter).
+
+    How it works:
+        - consecutiveWeeks(first, count) lists ISO weeks starting at first,
+          crossing year ends correctly (Dates::weekStart / weekOf).
+        - generate(weeks, wipe) takes one read-only snapshot: the
+          DemandMatrix and the pantry supply over its columns. Every week is then planned by MealOptimizer as its own
+          ThreadPool task against that shared snapshot (the optimizer runs
+          serially inside the task, so tasks never wait on the pool).
+        - Weeks are independent: each sees the same pantry, and each gets
+          a different tie-break rotation so equal-cost recipes vary from
+          week to week.
+        - All entries (and the optional clear of those weeks) are committed
+          with one MealPlan::saveEntries() call: one write per week
+          partition, no per-day writes.
+        - When no week gets any entry (no recipe has ingredient amounts)
+          nothing is committed, so existing plans are kept even with wipe.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/dates.h"
+    #include "../../vendor/sys/threadpool.h"
+    #include "../recipemanager/recipe.cpp"
+    #include "../pantrymanager/pantry.cpp"
+    #include "mealplan.cpp"
+    #include "demandmatrix.cpp"
+    #include "mealoptimizer.cpp"
+
+    BulkPlanner:
+        public:
+            - Result                    : Outcome of one bulk generation
+            - consecutiveWeeks(first, count) : ISO week labels from first (static)
+            - generate(weeks, wipe)     : Plan and save every week (static)
+*/
+struct BulkPlanner {
+public:
+    struct Result {
+        vector<string> weeks;                       // weeks planned
+        vector<MealPlan> entries;                   // saved entries, week by week
+        int purchases = 0;                          // sum of per-week purchases
+        bool saved = false;                         // meal plan written
+    };
+
+    /*
+        ISO week labels starting at first (empty if first is not ISO)
+    */
+    static vector<string> consecutiveWeeks(string first, int count) {
+        vector<string> weeks;
+        int y = 0, w = 0;
+        if (!Dates::parseWeek(first, y, w)) return weeks;
+        int monday = Dates::weekStart(y, w);
+        for (int i = 0; i < count; i++) {
+            int wy = 0, ww = 0;
+            Dates::weekOf(monday + 7 * i, wy, ww);
+            weeks.push_back(Dates::formatWeek(wy, ww));
+        }
+        return weeks;
+    }
+
+    /*
+        Plan every week concurrently and save them together
+    */
+    static Result generate(vector<string> weeks, bool wipe) {
+        Result result;
+        result.weeks = weeks;
+        if (weeks.empty()) return result;
+
+        DemandMatrix& matrix = DemandMatrix::shared();  // read-only snapshot
+        const vector<double> supply = MealOptimizer::supplyOf(matrix, Pantry::loadAll());
+
+        ThreadPool& pool = ThreadPool::shared();
+        size_t stride = weeks.size() == 0 ? 0 : matrix.recipeIds.size() / weeks.size();
+        vector<future<MealOptimizer::Plan>> pending;
+        for (size_t i = 0; i < weeks.size(); i++) {
+            MealOptimizer::Options options;
+            options.parallel = false;               // one task per week
+            options.rotate = int(i * stride);
+            pending.push_back(pool.submit([&matrix, &supply, options]() {
+                return MealOptimizer::plan(matrix, supply, options);
+            }));
+        }
+
+        string days[7] = {"Mon","Tue","Wed","Thu","Fri","Sat","Sun"};
+        for (size_t i = 0; i < weeks.size(); i++) {
+            MealOptimizer::Plan plan = pending[i].get();    // wait in week order
+            result.purchases += plan.purchases;
+            for (size_t d = 0; d < plan.recipeIds.size() && d < 7; d++) {
+                result.entries.push_back(MealPlan(weeks[i], days[d], plan.recipeIds[d]));
+            }
+        }
+
+        if (result.entries.empty()) return result;  // nothing planned: keep existing weeks
+        result.saved = MealPlan::saveEntries(result.entries, wipe ? weeks : vector<string>());   // one batched commit
+        return result;
+    }
+};
+
+#endif                                              // BULKPLANNER_H
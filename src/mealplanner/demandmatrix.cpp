@@ -0,0 +1,280 @@
+#ifndef DEMANDMATRIX_H                          // for no dup def
+#define DEMANDMATRIX_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/units.h"
+#include "../../vendor/sys/threadpool.h"
+#include "../recipemanager/recipe.cpp"
+#include "mealplan.cpp"
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+    DemandMatrix Struct
+
+    Sparse recipe x ingredient matrix used to forecast ingredient demand for
+    many meal-plan weeks at once.
+
+    How it works:
+        - build() reads the catalog once and interns every ingredient as a
+          column keyed by (name, canonical unit). Amounts are stored in base
+          units: mass in g, volume in ml (or g when the ingredient has a
+          known density, so "2 cups flour" and "200 g flour" share a
+          column), count in pieces. Unknown units keep their own spelling.
+          Ingredients without an amount are not forecast.
+        - The matrix is stored in CSR form (rowPtr / colIdx / values, one
+          row per recipe). Its transpose (one row per ingredient) is kept as
+          well, so the product runs row-parallel with no write conflicts.
+        - forecast(weeks) fills a dense servings block X (recipes x weeks,
+          weeks contiguous) from the meal plan, reading only the requested
+          week partitions, one serving per planned meal,
+          and computes Y = A^T X. Each ingredient row is a gather
+          over its recipes; the inner loop over weeks is contiguous and
+          branch-free so the compiler vectorizes it. Rows are split across
+          ThreadPool::shared() with parallelFor().
+        - weeksIn() lists every planned week in first-seen order, for
+          forecasting the whole plan at once.
+        - shared() caches the matrix until Recipe::tableVersion() changes.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/units.h"
+    #include "../../vendor/sys/threadpool.h"
+    #include "../recipemanager/recipe.cpp"
+    #include "mealplan.cpp"
+
+    DemandMatrix:
+        public:
+            - Column                    : Ingredient name and canonical unit
+            - Forecast                  : Weeks x ingredients totals
+            - recipeIds / rowOf         : Matrix row -> recipe id and back
+            - baseServings              : Row -> servings its amounts make (0 = unknown)
+            - columns / columnOf        : Interned ingredients and their lookup
+            - rowPtr / colIdx / values  : CSR recipes x ingredients
+            - tRowPtr / tColIdx / tValues : CSR ingredients x recipes (transpose)
+            - canonical(amount, unit, name, value, canonUnit) : Amount in base unit (static)
+            - key(name, canonUnit)      : Column lookup key (static)
+            - columnFor(name, quantity, unit, amount) : Column of a stock amount (-1 if unused)
+            - build(recipes)            : Build both CSR forms from a catalog
+            - multiply(servings, weeks) : Y = A^T X for a dense servings block
+            - forecast(weeks)           : Per-week, per-ingredient totals (all weeks if empty)
+            - weeksIn(plan)             : Distinct week labels in plan order (static)
+            - shared()                  : Matrix for the current recipe table (static)
+        private:
+            - version                   : Recipe::tableVersion() at build
+            - transpose()               : Build the ingredient-major CSR
+*/
+struct DemandMatrix {
+public:
+    struct Column {
+        string name;                                // first spelling seen
+        string unit;                                // canonical unit
+    };
+
+    struct Forecast {
+        vector<string> weeks;                       // requested weeks, in order
+        vector<Column> columns;                     // ingredients
+        vector<double> totals;                      // ingredient-major: totals[i * weeks + w]
+        int meals = 0;                              // planned meals counted
+        int missingRecipes = 0;                     // planned ids not in the catalog
+    };
+
+    vector<int> recipeIds;                          // row -> recipe id
+    unordered_map<int, int> rowOf;                  // recipe id -> row
+    vector<int> baseServings;                       // row -> Recipe::servings
+    vector<Column> columns;                         // column -> ingredient
+    unordered_map<string, int> columnOf;            // key(name, unit) -> column
+    vector<size_t> rowPtr;                          // CSR recipes x ingredients
+    vector<int> colIdx;
+    vector<double> values;
+    vector<size_t> tRowPtr;                         // CSR ingredients x recipes
+    vector<int> tColIdx;
+    vector<double> tValues;
+
+    /*
+        Amount in its canonical base unit (false when there is no amount)
+    */
+    static bool canonical(double amount, string unit, string name, double& value, string& canonUnit) {
+        if (amount <= 0.0) return false;           // nothing to forecast
+        double base = 0.0; Units::Dimension dim = Units::NONE;
+        if (!Units::toBase(amount, unit, base, dim)) {  // unknown or empty unit
+            value = amount;
+            canonUnit = Units::normalize(unit);
+            return true;
+        }
+        if (dim == Units::VOLUME && Units::density(name) > 0.0) {  // volume -> mass
+            base *= Units::density(name);
+            dim = Units::MASS;
+        }
+        value = base;
+        canonUnit = dim == Units::MASS ? "g" : dim == Units::VOLUME ? "ml" : "piece";
+        return true;
+    }
+
+    /*
+        Column lookup key: folded name and canonical unit
+    */
+    static string key(string name, string canonUnit) {
+        return out.toLowerCase(name) + '\x1f' + canonUnit;
+    }
+
+    /*
+        Column a stocked amount counts toward, with the amount in its unit
+            - -1 when no recipe uses that ingredient in that dimension
+    */
+    int columnFor(string name, double quantity, string unit, double& amount) {
+        double factor = 0.0; string canonUnit = "";
+        canonical(1.0, unit, name, factor, canonUnit);
+        auto col = columnOf.find(key(name, canonUnit));
+        if (col == columnOf.end()) return -1;
+        amount = quantity > 0.0 ? quantity * factor : 0.0;
+        return col->second;
+    }
+
+    /*
+        Build the CSR matrix (and its transpose) from a catalog
+    */
+    void build(const vector<Recipe>& recipes) {
+        recipeIds.clear(); rowOf.clear(); baseServings.clear(); columns.clear(); columnOf.clear();
+        rowPtr.assign(1, 0); colIdx.clear(); values.clear();
+        for (size_t r = 0; r < recipes.size(); r++) {
+            map<int, double> row;                   // column -> amount (sorted, duplicates summed)
+            for (size_t i = 0; i < recipes[r].ingredients.size(); i++) {
+                string name = ""; string amountText = ""; string unit = "";
+                Recipe::splitIngredient(recipes[r].ingredients[i], name, amountText, unit);
+                double amount = 0.0, value = 0.0; string canonUnit = "";
+                if (name == "" || !out.parseNumber(amountText, amount)) continue;
+                if (!canonical(amount, unit, name, value, canonUnit)) continue;
+                auto hit = columnOf.emplace(key(name, canonUnit), int(columns.size()));
+                if (hit.second) columns.push_back({ name, canonUnit });     // new ingredient
+                row[hit.first->second] += value;
+            }
+            rowOf[recipes[r].id] = int(recipeIds.size());
+            recipeIds.push_back(recipes[r].id);
+            baseServings.push_back(recipes[r].servings);
+            for (auto& cell : row) { colIdx.push_back(cell.first); values.push_back(cell.second); }
+            rowPtr.push_back(colIdx.size());
+        }
+        transpose();
+        version = Recipe::tableVersion();
+    }
+
+    /*
+        Y = A^T X
+            - servings: recipes x weeks, row-major (weeks contiguous)
+            - returns ingredients x weeks, row-major
+    */
+    vector<double> multiply(const vector<double>& servings, int weeks) {
+        size_t n = columns.size();
+        vector<double> result(n * size_t(weeks), 0.0);
+        if (weeks <= 0 || n == 0) return result;
+        const size_t* ptr = tRowPtr.data();
+        const int* idx = tColIdx.data();
+        const double* val = tValues.data();
+        const double* x = servings.data();
+        double* y = result.data();
+        ThreadPool::shared().parallelFor(n, [&](int, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {  // one ingredient per row
+                double* out_i = y + i * size_t(weeks);
+                for (size_t k = ptr[i]; k < ptr[i + 1]; k++) {
+                    const double a = val[k];
+                    const double* x_r = x + size_t(idx[k]) * size_t(weeks);
+                    for (int w = 0; w < weeks; w++) {   // contiguous, vectorizable
+                        out_i[w] += a * x_r[w];
+                    }
+                }
+            }
+        }, 256);
+        return result;
+    }
+
+    /*
+        Per-week, per-ingredient totals for meal-plan weeks
+    */
+    Forecast forecast(vector<string> weeks) {
+        Forecast result;
+        vector<MealPlan> plan;
+        if (weeks.empty()) {                        // no weeks given: whole plan
+            plan = MealPlan::loadAll();
+            weeks = weeksIn(plan);
+        }
+        result.weeks = weeks;
+        result.columns = columns;
+        int w = int(weeks.size());
+        unordered_map<string, int> weekOf;          // canonical week -> column
+        for (int i = 0; i < w; i++) weekOf.emplace(MealPlan::weekKey(weeks[i]), i);    // first spelling wins
+        if (plan.empty()) {                         // read only the requested weeks
+            for (auto& week : weekOf) {
+                vector<MealPlan> part = MealPlan::findByWeek(week.first);
+                plan.insert(plan.end(), part.begin(), part.end());
+            }
+        }
+
+        vector<double> servings(recipeIds.size() * size_t(w), 0.0);     // dense block X
+        for (size_t i = 0; i < plan.size(); i++) {
+            auto week = weekOf.find(MealPlan::weekKey(plan[i].week));
+            if (week == weekOf.end()) continue;     // not requested
+            auto row = rowOf.find(plan[i].recipeId);
+            if (row == rowOf.end()) { result.missingRecipes++; continue; }
+            servings[size_t(row->second) * size_t(w) + size_t(week->second)] += 1.0;   // one serving per meal
+            result.meals++;
+        }
+        result.totals = multiply(servings, w);
+        return result;
+    }
+
+    /*
+        Distinct weeks, in the order they first appear
+    */
+    static vector<string> weeksIn(const vector<MealPlan>& plan) {
+        vector<string> weeks;
+        unordered_map<string, bool> seen;
+        for (size_t i = 0; i < plan.size(); i++) {
+            string week = MealPlan::weekKey(plan[i].week);
+            if (seen.emplace(week, true).second) weeks.push_back(week);
+        }
+        return weeks;
+    }
+
+    /*
+        Matrix for the current recipe table (rebuilt after recipe changes)
+    */
+    static DemandMatrix& shared() {
+        static DemandMatrix matrix;
+        static bool built = false;
+        if (!built || matrix.version != Recipe::tableVersion()) {
+            matrix.build(Recipe::loadAll());        // one catalog read
+            built = true;
+        }
+        return matrix;
+    }
+
+private:
+    unsigned long long version = 0;                 // recipe table version at build
+
+    /*
+        Build the ingredient-major CSR (counting sort by column)
+    */
+    void transpose() {
+        size_t n = columns.size();
+        tRowPtr.assign(n + 1, 0);
+        for (size_t k = 0; k < colIdx.size(); k++) tRowPtr[size_t(colIdx[k]) + 1]++;
+        for (size_t i = 0; i < n; i++) tRowPtr[i + 1] += tRowPtr[i];
+        tColIdx.assign(colIdx.size(), 0);
+        tValues.assign(values.size(), 0.0);
+        vector<size_t> next(tRowPtr.begin(), tRowPtr.end() - 1);
+        for (size_t r = 0; r + 1 < rowPtr.size(); r++) {   // rows ascending keeps recipes sorted
+            for (size_t k = rowPtr[r]; k < rowPtr[r + 1]; k++) {
+                size_t slot = next[size_t(colIdx[k])]++;
+                tColIdx[slot] = int(r);
+                tValues[slot] = values[k];
+            }
+        }
+    }
+};
+
+#endif                                              // DEMANDMATRIX_H
@@ -0,0 +1,112 @@
+#include "../../vendor/sys/out.h"
+#include "../../vendor/base/modal.h"
+#include "demandmatrix.cpp"
+#include <algorithm>
+
+using namespace std;
+
+/*
+    ForecastDemandModal Class
+
+    This modal forecasts ingredient demand for several meal-plan weeks at once.
+
+    How it works:
+        - Prompts for comma-separated week labels (blank for every week);
+          an ISO range like 2025-W10..2025-W20 expands to the planned weeks
+          in it (MealPlan::weeksBetween(), no full scan)
+        - Runs DemandMatrix::forecast() on the cached recipe matrix
+        - Lists each ingredient with its total per week, in base units
+        - Automatically returns to parent page after completion
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/base/modal.h"
+    #include "demandmatrix.cpp"
+
+    ForecastDemandModal:
+        private:
+            - promptWeeks(all)          : Prompts for week labels and ranges
+        protected:
+            - schema()                  : Main modal logic (override from Modal)
+        public:
+            - ForecastDemandModal()     : Constructor
+*/
+class ForecastDemandModal : public Modal {
+private:
+    /*
+        Prompt for week labels and ranges (empty list = every week)
+    */
+    vector<string> promptWeeks(bool& all) {
+        string text = out.inputs("Enter weeks, comma separated (2025-W10..2025-W20 for a range, blank for all): ");
+        vector<string> weeks;
+        all = out.trim(text) == "";
+        size_t start = 0;
+        while (start <= text.length()) {
+            size_t comma = text.find(',', start);
+            if (comma == string::npos) comma = text.length();
+            string week = out.trim(text.substr(start, comma - start));
+            start = comma + 1;
+            vector<string> found = { week };
+            size_t dots = week.find("..");
+            if (dots != string::npos) {             // ISO week range
+                found = MealPlan::weeksBetween(out.trim(week.substr(0, dots)), out.trim(week.substr(dots + 2)));
+            }
+            for (size_t i = 0; i < found.size(); i++) {
+                if (found[i] != "" && find(weeks.begin(), weeks.end(), found[i]) == weeks.end()) weeks.push_back(found[i]);
+            }
+        }
+        return weeks;
+    }
+
+protected:
+    /*
+        Main modal schema - Per-week ingredient totals
+    */
+    void schema() override {
+        out.hr();                                   // horizontal rule
+        out.br();
+        bool all = false;
+        vector<string> weeks = promptWeeks(all);
+        out.br();
+        if (!all && weeks.empty()) {                // e.g. a range with no planned weeks
+            out.coutln("No planned weeks found for that selection.");
+            out.br();
+            return;                                 // exit modal
+        }
+
+        DemandMatrix::Forecast result = DemandMatrix::shared().forecast(weeks);
+        if (result.meals == 0) {                    // nothing planned
+            out.coutln("No planned meals found for the selected week(s).");
+            out.br();
+            return;                                 // exit modal
+        }
+        if (result.missingRecipes > 0) {            // plan points at deleted recipes
+            out.coutln("Warning: " + to_string(result.missingRecipes) + " planned recipe(s) no longer exist and were skipped.");
+        }
+
+        size_t w = result.weeks.size();
+        out.coutln("Demand for " + to_string(result.meals) + " meal(s) over " + to_string(w) + " week(s):");
+        out.br();
+        int n = 1;
+        for (size_t i = 0; i < result.columns.size(); i++) {
+            const double* totals = result.totals.data() + i * w;
+            string line = "";
+            bool any = false;
+            for (size_t k = 0; k < w; k++) {
+                if (totals[k] > 0.0) any = true;
+                line += (k ? ", " : "") + result.weeks[k] + ": " + out.formatNumber(totals[k]);
+            }
+            if (!any) continue;                     // not needed in these weeks
+            DemandMatrix::Column c = result.columns[i];
+            string unit = c.unit == "" ? "" : " (" + c.unit + ")";
+            out.coutln(to_string(n++) + ". " + c.name + unit + " - " + line);
+        }
+        out.br();
+    }
+
+public:
+    /*
+        Constructor
+    */
+    ForecastDemandModal() : Modal() {}              // default constructor
+};
@@ -1,7 +1,9 @@
 #include "../../vendor/sys/out.h"
 #include "../../vendor/base/modal.h"
 #include "mealplan.cpp"
+#include "mealoptimizer.cpp"
 #include "../recipemanager/recipe.cpp"
+#include <unordered_map>
 
 using namespace std;
 
@@ -14,13 +16,17 @@ using namespace std;
     How it works:
         - Ask for week label (any string)
         - Optionally clear existing plan for that week
-        - Ask to auto-fill or manual pick
-        - Save 7 entries (Mon..Sun) to mealplan.csv
+        - Ask to auto-fill or manual pick; auto-fill lets MealOptimizer
+          choose the 7 recipes needing the fewest purchases given the
+          pantry (no repeats within the week when the catalog allows)
+        - Save 7 entries (Mon..Sun) to the meal plan with one
+          MealPlan::saveWeek() write (the optional clear included)
 
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/base/modal.h"
     #include "mealplan.cpp"
+    #include "mealoptimizer.cpp"
     #include "../recipemanager/recipe.cpp"
 
     GenerateMealPlanModal:
@@ -36,27 +42,35 @@ protected:
         string week = out.inputs("Enter week label (e.g., 2025-W43): ");
         if (week == "") { week = "Week"; }
         bool wipe = out.inputYesNo("Clear existing plan for this week? (y/n): ");
-        if (wipe) { MealPlan::clearWeek(week); }
         out.br();
 
         vector<Recipe> recipes = Recipe::loadAll();
         if (recipes.size() == 0) {
+            if (wipe) { MealPlan::clearWeek(week); }
             out.coutln("No recipes available. Please add recipes first.");
             return;
         }
 
-        bool autoFill = out.inputYesNo("Auto-fill 7 days using available recipes? (y/n): ");
+        bool autoFill = out.inputYesNo("Auto-fill 7 days from your pantry (fewest purchases)? (y/n): ");
         out.br();
 
         string days[7] = {"Mon","Tue","Wed","Thu","Fri","Sat","Sun"};
+        vector<MealPlan> entries;                   // saved together at the end
 
         if (autoFill) {
+            MealOptimizer::Plan best = MealOptimizer::plan(MealOptimizer::Options());
+            unordered_map<int, size_t> byId;
+            for (size_t i = 0; i < recipes.size(); i++) { byId[recipes[i].id] = i; }
             for (int i = 0; i < 7; i++) {
-                Recipe r = recipes[i % recipes.size()];
-                MealPlan mp(week, days[i], r.id, r.name);
-                mp.save();
+                Recipe r = recipes[i % recipes.size()];     // fallback when nothing could be planned
+                if (i < best.recipeIds.size() && byId.count(best.recipeIds[i])) { r = recipes[byId[best.recipeIds[i]]]; }
+                entries.push_back(MealPlan(week, days[i], r.id));
             }
+            if (!MealPlan::saveWeek(week, entries, wipe)) { out.coutln("Error: Could not save meal plan."); return; }
             out.coutln("Meal plan generated for week: " + week);
+            if (best.recipeIds.size() > 0) {
+                out.coutln(to_string(best.purchases) + " ingredient(s) to buy, " + to_string(best.covered) + " ingredient use(s) from your pantry.");
+            }
             return;
         }
 
@@ -75,10 +89,10 @@ protected:
                 out.coutln("Invalid choice. Try again.");
             }
             Recipe chosen = recipes[pick - 1];
-            MealPlan mp2(week, days[i], chosen.id, chosen.name);
-            mp2.save();
+            entries.push_back(MealPlan(week, days[i], chosen.id));
             out.br();
         }
+        if (!MealPlan::saveWeek(week, entries, wipe)) { out.coutln("Error: Could not save meal plan."); return; }
         out.coutln("Meal plan saved for week: " + week);
     }
 
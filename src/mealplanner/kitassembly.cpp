@@ -0,0 +1,220 @@
+#ifndef KITASSEMBLY_H                           // for no dup def
+#define KITASSEMBLY_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/threadpool.h"
+#include "../recipemanager/recipe.cpp"
+#include "demandmatrix.cpp"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <charconv>
+
+using namespace std;
+
+/*
+    KitAssembly Struct
+
+    Turns an order manifest (meal kits to pack) into per-ingredient pick
+    totals for the warehouse.
+
+    How it works:
+        - An order line is (recipe id, servings, count): `count` kits of
+          that recipe, each for `servings` people. Amounts come from the
+          recipe's DemandMatrix row (canonical units: g, ml, piece) and are
+          scaled by Recipe::scaleFor(base servings, servings) x count.
+          Servings 0 means the recipe as written; recipes without base
+          servings are never scaled (counted in `unscaled`).
+        - The reduction is split over ThreadPool::shared() with
+          parallelFor(). Every chunk adds into its own dense totals vector
+          (one slot per matrix column), so workers never share a write;
+          the chunk vectors are summed once at the end.
+        - assembleFile() streams a manifest CSV from ./data in batches of
+          BATCH lines: the calling thread only reads raw lines, parsing and
+          scaling run inside the chunks. Memory stays at one batch plus one
+          totals vector per worker, whatever the manifest size.
+        - Manifest rows are "recipeId,servings,count"; a non-numeric first
+          line is taken as a header. Malformed rows and unknown recipe ids
+          are counted in `skipped`.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/threadpool.h"
+    #include "../recipemanager/recipe.cpp"
+    #include "demandmatrix.cpp"
+
+    KitAssembly:
+        public:
+            - Order                     : One manifest line
+            - Pick                      : Total of one ingredient to pick
+            - Result                    : Pick list and line counters
+            - assemble(orders)          : Reduce order lines held in memory (static)
+            - assembleFile(file, result) : Stream a manifest from ./data (static)
+            - parseLine(line, order)    : Parse one manifest row (static)
+        private:
+            - BATCH                     : Lines read per streamed batch
+            - Totals                    : Per-chunk accumulator
+            - add(matrix, order, totals) : Add one order line (static)
+            - finish(matrix, partial, used) : Merge chunks into a Result (static)
+*/
+struct KitAssembly {
+public:
+    struct Order {
+        int recipeId = 0;
+        int servings = 0;                           // per kit (0 = as written)
+        long long count = 0;                        // kits
+    };
+
+    struct Pick {
+        string name;                                // ingredient
+        string unit;                                // canonical unit
+        double amount = 0.0;                        // total to pick
+    };
+
+    struct Result {
+        vector<Pick> picks;                         // column order, non-zero only
+        long long lines = 0;                        // order lines reduced
+        long long kits = 0;                         // kits packed
+        long long skipped = 0;                      // malformed lines / unknown recipes
+        long long unscaled = 0;                     // lines whose recipe has no base servings
+    };
+
+    /*
+        Reduce order lines already in memory
+    */
+    static Result assemble(const vector<Order>& orders) {
+        DemandMatrix& matrix = DemandMatrix::shared();
+        ThreadPool& pool = ThreadPool::shared();
+        vector<Totals> partial(max<size_t>(1, pool.size()));    // one accumulator per chunk
+        int used = pool.parallelFor(orders.size(), [&](int chunk, size_t begin, size_t end) {
+            Totals& local = partial[chunk];
+            local.reset(matrix.columns.size());
+            for (size_t i = begin; i < end; i++) add(matrix, orders[i], local);
+        }, 4096);
+        return finish(matrix, partial, used);
+    }
+
+    /*
+        Stream a manifest file from ./data (false if it cannot be opened)
+    */
+    static bool assembleFile(string filename, Result& result) {
+        ifstream file("./data/" + filename);
+        if (!file.is_open()) return false;
+
+        DemandMatrix& matrix = DemandMatrix::shared();
+        ThreadPool& pool = ThreadPool::shared();
+        vector<Totals> partial(max<size_t>(1, pool.size()));
+        for (size_t c = 0; c < partial.size(); c++) partial[c].reset(matrix.columns.size());
+
+        vector<string> batch(BATCH);                // reused line buffers
+        bool first = true;
+        while (true) {
+            size_t n = 0;
+            while (n < BATCH && getline(file, batch[n])) {
+                if (first) {                        // optional header row
+                    first = false;
+                    Order probe;
+                    if (!parseLine(batch[n], probe) && batch[n].find_first_of("0123456789") != 0) continue;
+                }
+                n++;
+            }
+            if (n == 0) break;
+            pool.parallelFor(n, [&](int chunk, size_t begin, size_t end) {
+                Totals& local = partial[chunk];     // kept across batches
+                for (size_t i = begin; i < end; i++) {
+                    Order order;
+                    if (parseLine(batch[i], order)) add(matrix, order, local);
+                    else if (out.trim(batch[i]) != "") local.skipped++;
+                }
+            }, 4096);
+            if (n < BATCH) break;                   // end of file
+        }
+        result = finish(matrix, partial, int(partial.size()));
+        return true;
+    }
+
+    /*
+        Parse "recipeId,servings,count" (false if malformed)
+    */
+    static bool parseLine(const string& line, Order& order) {
+        const char* p = line.data();
+        const char* end = p + line.size();
+        long long fields[3] = { 0, 0, 0 };
+        for (int f = 0; f < 3; f++) {
+            while (p < end && (*p == ' ' || *p == '\t')) p++;
+            if (f == 1 && p < end && *p == ',') { fields[f] = 0; }      // blank servings
+            else {
+                from_chars_result r = from_chars(p, end, fields[f]);
+                if (r.ec != errc()) return false;
+                p = r.ptr;
+            }
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+            if (f < 2) {
+                if (p == end || *p != ',') return false;
+                p++;
+            }
+        }
+        if (p != end) return false;                 // trailing text
+        if (fields[0] <= 0 || fields[1] < 0 || fields[2] < 1) return false;
+        order.recipeId = int(fields[0]);
+        order.servings = int(fields[1]);
+        order.count = fields[2];
+        return true;
+    }
+
+private:
+    static constexpr size_t BATCH = 1 << 16;        // lines per streamed batch
+
+    struct Totals {
+        vector<double> amounts;                     // column -> amount
+        long long lines = 0;
+        long long kits = 0;
+        long long skipped = 0;
+        long long unscaled = 0;
+
+        void reset(size_t columns) {
+            amounts.assign(columns, 0.0);
+            lines = kits = skipped = unscaled = 0;
+        }
+    };
+
+    /*
+        Add one order line's scaled recipe row
+    */
+    static void add(const DemandMatrix& matrix, const Order& order, Totals& totals) {
+        auto row = matrix.rowOf.find(order.recipeId);
+        if (row == matrix.rowOf.end() || order.count < 1) { totals.skipped++; return; }
+        size_t r = size_t(row->second);
+        int base = matrix.baseServings[r];
+        if (order.servings > 0 && base <= 0) totals.unscaled++;
+        double factor = Recipe::scaleFor(base, order.servings) * double(order.count);
+        for (size_t k = matrix.rowPtr[r]; k < matrix.rowPtr[r + 1]; k++) {
+            totals.amounts[matrix.colIdx[k]] += factor * matrix.values[k];
+        }
+        totals.lines++;
+        totals.kits += order.count;
+    }
+
+    /*
+        Sum the first `used` chunk accumulators into a pick list
+    */
+    static Result finish(const DemandMatrix& matrix, vector<Totals>& partial, int used) {
+        Result result;
+        vector<double> sum(matrix.columns.size(), 0.0);
+        for (int c = 0; c < used; c++) {
+            Totals& t = partial[c];
+            for (size_t col = 0; col < t.amounts.size(); col++) sum[col] += t.amounts[col];
+            result.lines += t.lines;
+            result.kits += t.kits;
+            result.skipped += t.skipped;
+            result.unscaled += t.unscaled;
+        }
+        for (size_t col = 0; col < sum.size(); col++) {
+            if (sum[col] <= 0.0) continue;          // not picked
+            result.picks.push_back({ matrix.columns[col].name, matrix.columns[col].unit, sum[col] });
+        }
+        return result;
+    }
+};
+
+#endif                                              // KITASSEMBLY_H
@@ -0,0 +1,228 @@
+#ifndef MEALOPTIMIZER_H                         // for no dup def
+#define MEALOPTIMIZER_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/threadpool.h"
+#include "../pantrymanager/pantry.cpp"
+#include "demandmatrix.cpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+/*
+    MealOptimizer Struct
+
+    Picks the recipes for N days so that as few ingredients as possible
+    have to be bought and as much pantry stock as possible gets used.
+
+    How it works:
+        - Works on the DemandMatrix rows (sparse ingredient lists in
+          canonical units) and a pantry supply vector over the same
+          columns. Recipes whose ingredients have no amounts are skipped.
+        - Cost of a plan: purchases = distinct ingredients whose planned
+          amount exceeds pantry stock (lower is better), then covered =
+          ingredient uses fully served from the pantry (higher is better).
+        - Beam search, one day per step. Each state keeps its picks, the
+          pantry stock it has left and a bitset of ingredients it already
+          has to buy (buying flour once covers every recipe that needs it).
+        - Each step scores every (state, recipe) pair in parallel over the
+          catalog with ThreadPool::shared().parallelFor(); every chunk keeps
+          its own top-`beam` list, which are merged into the next beam.
+          A step costs O(recipes x beam x ingredients per recipe).
+        - A recipe may not repeat within `noRepeatDays` days. When the
+          catalog is too small for that, the step is retried allowing
+          repeats.
+        - Options.parallel = false scores on the calling thread, so several
+          plans can run as separate pool tasks (BulkPlanner) without
+          nesting parallelFor() inside a pool worker. Options.rotate shifts
+          which recipe wins a tie, so plans made against the same pantry
+          differ where costs are equal.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/threadpool.h"
+    #include "../pantrymanager/pantry.cpp"
+    #include "demandmatrix.cpp"
+
+    MealOptimizer:
+        public:
+            - Options                   : Days, repeat window and beam width
+            - Plan                      : Chosen recipe ids and plan cost
+            - supplyOf(matrix, rows)    : Pantry stock per matrix column (static)
+            - plan(options)             : Best plan for the current pantry (static)
+            - plan(matrix, supply, options) : Best plan for a given stock (static)
+        private:
+            - State                     : One partial plan in the beam
+            - Candidate                 : One scored (state, recipe) extension
+            - better(a, b)              : Candidate order (static)
+            - keep(list, c, width)      : Insert into a bounded top list (static)
+            - expand(matrix, beam, noRepeatDays, options) : Best extensions of a beam (static)
+*/
+struct MealOptimizer {
+public:
+    struct Options {
+        int days = 7;                               // recipes to pick
+        int noRepeatDays = 6;                       // a recipe may not repeat within this many days
+        int beam = 16;                              // states kept per step
+        bool parallel = true;                       // score on the shared pool
+        int rotate = 0;                             // tie-break offset over recipes
+    };
+
+    struct Plan {
+        vector<int> recipeIds;                      // one per day
+        int purchases = 0;                          // distinct ingredients to buy
+        int covered = 0;                            // ingredient uses served from the pantry
+    };
+
+    /*
+        Pantry stock per matrix column
+    */
+    static vector<double> supplyOf(DemandMatrix& matrix, const vector<Pantry>& rows) {
+        vector<double> supply(matrix.columns.size(), 0.0);
+        for (size_t i = 0; i < rows.size(); i++) {
+            double amount = 0.0;
+            int col = matrix.columnFor(rows[i].name, rows[i].quantity, rows[i].unit, amount);
+            if (col >= 0) supply[col] += amount;
+        }
+        return supply;
+    }
+
+    /*
+        Best plan for the current catalog and pantry
+    */
+    static Plan plan(Options options) {
+        DemandMatrix& matrix = DemandMatrix::shared();
+        return plan(matrix, supplyOf(matrix, Pantry::loadAll()), options);
+    }
+
+    /*
+        Best plan for a given matrix and stock (both read-only)
+    */
+    static Plan plan(const DemandMatrix& matrix, const vector<double>& supply, Options options) {
+        Plan best;
+        size_t words = (matrix.columns.size() + 63) / 64;
+        vector<State> beam(1);
+        beam[0].bought.assign(words, 0);
+        beam[0].remaining = supply;
+        if (options.beam < 1) options.beam = 1;
+
+        for (int day = 0; day < options.days; day++) {
+            vector<Candidate> next = expand(matrix, beam, options.noRepeatDays, options);
+            if (next.empty()) next = expand(matrix, beam, 0, options);  // catalog too small: allow repeats
+            if (next.empty()) return best;          // no usable recipes
+
+            vector<State> grown;
+            grown.reserve(next.size());
+            for (size_t c = 0; c < next.size(); c++) {
+                State s = beam[next[c].state];
+                size_t r = size_t(next[c].row);
+                for (size_t k = matrix.rowPtr[r]; k < matrix.rowPtr[r + 1]; k++) {
+                    int col = matrix.colIdx[k];
+                    double need = matrix.values[k];
+                    if (need > s.remaining[col]) s.bought[col >> 6] |= uint64_t(1) << (col & 63);
+                    s.remaining[col] = need > s.remaining[col] ? 0.0 : s.remaining[col] - need;
+                }
+                s.rows.push_back(next[c].row);
+                s.purchases = next[c].purchases;
+                s.covered = next[c].covered;
+                grown.push_back(s);
+            }
+            beam.swap(grown);
+        }
+
+        const State& top = beam[0];                 // beam is kept sorted
+        for (size_t i = 0; i < top.rows.size(); i++) best.recipeIds.push_back(matrix.recipeIds[top.rows[i]]);
+        best.purchases = top.purchases;
+        best.covered = top.covered;
+        return best;
+    }
+
+private:
+    struct State {
+        vector<int> rows;                           // picked matrix rows, in day order
+        vector<uint64_t> bought;                    // bitset: ingredient already on the list
+        vector<double> remaining;                   // pantry stock left per column
+        int purchases = 0;
+        int covered = 0;
+    };
+
+    struct Candidate {
+        int state = 0;                              // beam index
+        int row = 0;                                // matrix row added
+        int order = 0;                              // row after rotation (tie-break)
+        int purchases = 0;                          // totals after adding
+        int covered = 0;
+    };
+
+    /*
+        Fewer purchases, then more pantry use, then stable by position
+    */
+    static bool better(const Candidate& a, const Candidate& b) {
+        if (a.purchases != b.purchases) return a.purchases < b.purchases;
+        if (a.covered != b.covered) return a.covered > b.covered;
+        if (a.state != b.state) return a.state < b.state;
+        return a.order < b.order;
+    }
+
+    /*
+        Insert a candidate into a sorted list holding at most width entries
+    */
+    static void keep(vector<Candidate>& list, const Candidate& c, int width) {
+        if (int(list.size()) == width && !better(c, list.back())) return;
+        list.insert(upper_bound(list.begin(), list.end(), c, better), c);
+        if (int(list.size()) > width) list.pop_back();
+    }
+
+    /*
+        Score every (state, recipe) extension and keep the best `width`
+    */
+    static vector<Candidate> expand(const DemandMatrix& matrix, const vector<State>& beam, int noRepeatDays, const Options& options) {
+        ThreadPool& pool = ThreadPool::shared();
+        size_t recipes = matrix.recipeIds.size();
+        int width = options.beam;
+        size_t shift = recipes == 0 ? 0 : size_t(max(0, options.rotate)) % recipes;
+        vector<vector<Candidate>> partial(max<size_t>(1, pool.size()));    // one top list per chunk
+
+        function<void(int, size_t, size_t)> score = [&](int chunk, size_t begin, size_t end) {
+            vector<Candidate>& local = partial[chunk];  // chunk-owned output
+            for (size_t r = begin; r < end; r++) {
+                size_t from = matrix.rowPtr[r], to = matrix.rowPtr[r + 1];
+                if (from == to) continue;           // nothing known to plan with
+                for (size_t s = 0; s < beam.size(); s++) {
+                    const State& state = beam[s];
+                    bool repeat = false;
+                    size_t window = min(state.rows.size(), size_t(max(0, noRepeatDays)));
+                    for (size_t d = state.rows.size() - window; d < state.rows.size(); d++) {
+                        if (state.rows[d] == int(r)) { repeat = true; break; }
+                    }
+                    if (repeat) continue;
+
+                    Candidate c;
+                    c.state = int(s); c.row = int(r);
+                    c.order = int((r + recipes - shift) % recipes);
+                    c.purchases = state.purchases; c.covered = state.covered;
+                    for (size_t k = from; k < to; k++) {
+                        int col = matrix.colIdx[k];
+                        if (matrix.values[k] <= state.remaining[col]) { c.covered++; continue; }
+                        if (!(state.bought[col >> 6] >> (col & 63) & 1)) c.purchases++;     // new item to buy
+                    }
+                    keep(local, c, width);
+                }
+            }
+        };
+        int used = 1;
+        if (options.parallel) used = pool.parallelFor(recipes, score, 512);
+        else score(0, 0, recipes);                  // caller is already a pool task
+
+        vector<Candidate> merged;
+        for (int c = 0; c < used; c++) {
+            for (size_t i = 0; i < partial[c].size(); i++) keep(merged, partial[c][i], width);
+        }
+        return merged;
+    }
+};
+
+#endif                                              // MEALOPTIMIZER_H
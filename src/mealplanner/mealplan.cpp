@@ -3,9 +3,17 @@
 
 #include "../../vendor/sys/out.h"
 #include "../../vendor/sys/csv.h"
+#include "../../vendor/sys/dates.h"
 #include "../recipemanager/recipe.cpp"
 #include <vector>
 #include <string>
+#include <functional>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <filesystem>
 
 using namespace std;
 
@@ -13,15 +21,35 @@ using namespace std;
     MealPlan Struct
 
     Represents a single planned meal for a specific week and day.
-    Stores the selected recipe id and name for easy display.
+    Stores only the selected recipe id; the name is joined at render time
+    through nameOf(), an id -> name cache rebuilt when
+    Recipe::tableVersion() changes, so a renamed or deleted recipe never
+    needs a meal-plan rewrite.
 
     How it works:
-        - Saved in CSV file mealplan.csv
+        - Saved partitioned by week under ./data/mealplan/:
+            - ISO week labels (2025-W43) go to one file per week named by
+              the zero-padded label, so file names sort in calendar order
+            - any other label (e.g. "Week") goes to other.csv
+            - the largest id is recovered by reading the partitions once per
+              session, so no separate counter file has to be written
+            - rows in a partition are kept sorted by day (Mon..Sun)
+        - The partition list is read from the directory once per session;
+          findByWeek() reads one partition and findRange() reads only the
+          partitions between two ISO weeks (ordered set range)
+        - An old single-file mealplan.csv is split into partitions on first
+          use and kept as mealplan.csv.bak
         - Provides helpers to save, load, find by week, and clear week
+        - Every write goes through saveEntries(): one read and one write per
+          touched partition for any number of upserts and cleared weeks, so
+          a generated week costs a single partition write
+        - listeners() are told about each entry added or removed once
+          mealplan.csv was written (a replaced day is a removal then an add)
 
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/sys/csv.h"
+    #include "../../vendor/sys/dates.h"
     #include "../recipemanager/recipe.cpp"
 
     MealPlan:
@@ -30,13 +58,26 @@ using namespace std;
             - week               : Week label (e.g., 2025-W43 or any string)
             - day                : Day label (Mon, Tue, ...)
             - recipeId           : Recipe ID from recipes.csv
-            - recipeName         : Cached recipe name for quick viewing
+            - recipeName()       : Recipe name, resolved through nameOf()
             - toCSVRow()         : Convert to CSV row
             - fromCSVRow(row)    : Build from CSV row
+            - nameOf(recipeId)   : Cached id -> name lookup (static)
             - save()             : Insert or replace entry for same week+day
-            - loadAll()          : Load all entries
-            - findByWeek(week)   : Load all entries for a given week
+            - saveWeek(week, entries, wipe) : Upsert a week's entries in one write
+            - saveEntries(entries, wipeWeeks) : Batched upsert/clear, one write per partition
+            - loadAll()          : Load all entries (weeks in calendar order)
+            - findByWeek(week)   : Load all entries for a given week (one partition)
+            - findRange(from, to) : Entries of ISO weeks from..to
+            - weeksBetween(from, to) : Planned ISO weeks from..to
             - clearWeek(week)    : Remove all entries for a given week
+            - listeners()        : Callbacks for entries added/removed (static)
+            - notifyChange(m, removed) : Run listeners for one entry (static)
+            - weekKey(week)      : Canonical week ("YYYY-Www" for ISO labels)
+            - partitionOf(week)  : Partition name for a week
+            - dayIndex(day)      : Mon..Sun as 0..6 (7 otherwise)
+        private:
+            - Store              : Partition list, id counter, partition I/O
+            - store()            : Shared Store instance
 */
 struct MealPlan {
 public:
@@ -44,14 +85,13 @@ public:
     string week;
     string day;
     int recipeId;
-    string recipeName;
 
     MealPlan() {
-        id = 0; week = ""; day = ""; recipeId = 0; recipeName = "";
+        id = 0; week = ""; day = ""; recipeId = 0;
     }
 
-    MealPlan(string w, string d, int rid, string rname) {
-        id = 0; week = w; day = d; recipeId = rid; recipeName = rname;
+    MealPlan(string w, string d, int rid) {
+        id = 0; week = w; day = d; recipeId = rid;
     }
 
     vector<string> toCSVRow() {
@@ -60,13 +100,13 @@ public:
         row.push_back(week);
         row.push_back(day);
         row.push_back(to_string(recipeId));
-        row.push_back(recipeName);
         return row;
     }
 
+    // [id, week, day, recipeId]; a 5th column (old cached name) is ignored
     static MealPlan fromCSVRow(vector<string> row) {
         MealPlan m;
-        if (row.size() >= 5) {
+        if (row.size() >= 4) {
             int parsedId = 0; int parsedRid = 0;
             try { parsedId = stoi(row[0]); } catch (...) { parsedId = 0; }
             try { parsedRid = stoi(row[3]); } catch (...) { parsedRid = 0; }
@@ -74,103 +114,281 @@ public:
             m.week = row[1];
             m.day = row[2];
             m.recipeId = parsedRid;
-            m.recipeName = row[4];
-        } else if (row.size() >= 4) {
-            int parsedId2 = 0; int parsedRid2 = 0;
-            try { parsedId2 = stoi(row[0]); } catch (...) { parsedId2 = 0; }
-            try { parsedRid2 = stoi(row[3]); } catch (...) { parsedRid2 = 0; }
-            m.id = parsedId2;
-            m.week = row[1];
-            m.day = row[2];
-            m.recipeId = parsedRid2;
-            m.recipeName = "";
         }
         return m;
     }
 
+    // name of the planned recipe, looked up at render time
+    string recipeName() const {
+        return nameOf(recipeId);
+    }
+
+    // id -> name cache, rebuilt when the recipe table changed
+    static string nameOf(int rid) {
+        static unordered_map<int, string> names;
+        static bool built = false;
+        static unsigned long long version = 0;
+        if (!built || version != Recipe::tableVersion()) {
+            names.clear();
+            vector<Recipe> recipes = Recipe::loadAll();
+            for (int i = 0; i < recipes.size(); i++) { names[recipes[i].id] = recipes[i].name; }
+            built = true;
+            version = Recipe::tableVersion();
+        }
+        auto hit = names.find(rid);
+        if (hit == names.end()) { return "(deleted recipe)"; }
+        return hit->second;
+    }
+
     void save() {
-        CSV csv("mealplan.csv");
-        vector<vector<string>> data = csv.read();
+        vector<MealPlan> one = { *this };
+        bool ok = saveEntries(one, {});
+        id = one[0].id;
+        if (ok) {
+            out.coutln("Saved meal plan for " + week + " - " + day + ": " + recipeName());
+        } else {
+            out.coutln("Error: Could not save meal plan.");
+        }
+        out.br();
+    }
 
-        // determine next id
-        int maxId = 0;
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i].size() >= 1) {
-                int val = 0; try { val = stoi(data[i][0]); } catch (...) { val = 0; }
-                if (val > maxId) { maxId = val; }
-            }
+    // all days of one week in one write (wipe = clear the week first)
+    static bool saveWeek(string w, vector<MealPlan>& entries, bool wipe) {
+        for (int i = 0; i < entries.size(); i++) { entries[i].week = w; }
+        vector<string> wipeWeeks;
+        if (wipe) { wipeWeeks.push_back(w); }
+        return saveEntries(entries, wipeWeeks);
+    }
+
+    // one read-modify-write per touched partition for any number of weeks:
+    // rows of wipeWeeks are dropped, then each entry replaces its week+day
+    // or is appended with the next id (ids are written back to entries)
+    static bool saveEntries(vector<MealPlan>& entries, vector<string> wipeWeeks) {
+        Store& table = store();
+        table.load();
+
+        map<string, vector<size_t>> byPartition;    // partition -> entries
+        unordered_set<string> wipe;
+        for (int i = 0; i < wipeWeeks.size(); i++) {
+            wipe.insert(weekKey(wipeWeeks[i]));
+            byPartition[partitionOf(wipeWeeks[i])];
         }
+        for (size_t i = 0; i < entries.size(); i++) { byPartition[partitionOf(entries[i].week)].push_back(i); }
 
-        // replace existing entry for same week + day
-        vector<vector<string>> newData;
-        bool replaced = false;
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i].size() >= 5) {
-                string w = data[i][1];
-                string d = data[i][2];
-                if (w == week && d == day) {
-                    if (id == 0) {
-                        int pid = 0;
-                        if (data[i][0] != "") {
-                            try { pid = stoi(data[i][0]); } catch (...) { pid = 0; }
-                        }
-                        id = pid;
-                    }
-                    vector<string> row = toCSVRow();
-                    newData.push_back(row);
-                    replaced = true;
+        bool ok = true;
+        for (auto& part : byPartition) {
+            vector<vector<string>> data = table.read(part.first);
+            vector<vector<string>> newData;
+            unordered_map<string, size_t> slot;     // week + day -> row in newData
+            vector<MealPlan> removed;
+            for (int i = 0; i < data.size(); i++) {
+                if (data[i].size() < 3) { continue; }
+                if (wipe.count(weekKey(data[i][1]))) {
+                    if (data[i].size() >= 4) { removed.push_back(fromCSVRow(data[i])); }
                     continue;
                 }
+                slot[weekKey(data[i][1]) + '\x1f' + data[i][2]] = newData.size();
+                newData.push_back(data[i]);
+            }
+            for (size_t n = 0; n < part.second.size(); n++) {
+                MealPlan& entry = entries[part.second[n]];
+                string key = weekKey(entry.week) + '\x1f' + entry.day;
+                auto hit = slot.find(key);
+                if (hit != slot.end()) {            // replace existing entry for same week + day
+                    MealPlan previous = fromCSVRow(newData[hit->second]);
+                    if (entry.id == 0) { entry.id = previous.id; }
+                    if (previous.recipeId != 0) { removed.push_back(previous); }
+                    newData[hit->second] = entry.toCSVRow();
+                    continue;
+                }
+                entry.id = ++table.maxId;
+                slot[key] = newData.size();
+                newData.push_back(entry.toCSVRow());
             }
-            newData.push_back(data[i]);
-        }
-
-        if (!replaced) {
-            id = maxId + 1;
-            newData.push_back(toCSVRow());
-        }
 
-        bool ok = csv.write(newData);
-        if (ok) {
-            out.coutln("Saved meal plan for " + week + " - " + day + ": " + recipeName);
-        } else {
-            out.coutln("Error: Could not save meal plan.");
+            if (!table.write(part.first, newData)) { ok = false; continue; }
+            for (int i = 0; i < removed.size(); i++) { notifyChange(removed[i], true); }
+            for (size_t n = 0; n < part.second.size(); n++) { notifyChange(entries[part.second[n]], false); }
         }
-        out.br();
+        return ok;
     }
 
     static vector<MealPlan> loadAll() {
+        Store& table = store();
+        table.load();
         vector<MealPlan> items;
-        CSV csv("mealplan.csv");
-        vector<vector<string>> data = csv.read();
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i].size() >= 4) {
-                items.push_back(fromCSVRow(data[i]));
-            }
-        }
+        for (auto& name : table.weeks) { table.collect(name, "", items); }     // calendar order
+        if (table.other) { table.collect(OTHER, "", items); }
         return items;
     }
 
+    // one partition; ISO spellings of the same week ("2025-W7", "2025-W07") match
     static vector<MealPlan> findByWeek(string w) {
-        vector<MealPlan> all = loadAll();
+        Store& table = store();
+        table.load();
         vector<MealPlan> result;
-        for (int i = 0; i < all.size(); i++) {
-            if (all[i].week == w) { result.push_back(all[i]); }
+        string part = partitionOf(w);
+        if (part == OTHER) {
+            if (table.other) { table.collect(OTHER, w, result); }
+        } else if (table.weeks.count(part)) {
+            table.collect(part, "", result);
         }
         return result;
     }
 
+    // ISO weeks from..to inclusive, touching only the partitions in range
+    static vector<MealPlan> findRange(string from, string to) {
+        Store& table = store();
+        table.load();
+        vector<MealPlan> result;
+        vector<string> weeks = weeksBetween(from, to);
+        for (int i = 0; i < weeks.size(); i++) { table.collect(weeks[i], "", result); }
+        return result;
+    }
+
+    // planned ISO weeks from..to inclusive, as "YYYY-Www" (empty if not ISO labels)
+    static vector<string> weeksBetween(string from, string to) {
+        Store& table = store();
+        table.load();
+        vector<string> weeks;
+        string lo = partitionOf(from); string hi = partitionOf(to);
+        if (lo == OTHER || hi == OTHER || hi < lo) { return weeks; }
+        for (auto it = table.weeks.lower_bound(lo); it != table.weeks.end() && *it <= hi; it++) {
+            weeks.push_back(*it);
+        }
+        return weeks;
+    }
+
     static void clearWeek(string w) {
-        CSV csv("mealplan.csv");
-        vector<vector<string>> data = csv.read();
-        vector<vector<string>> filtered;
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i].size() >= 3) {
-                if (data[i][1] == w) { continue; }
+        vector<MealPlan> none;
+        saveEntries(none, { w });
+    }
+
+    static vector<function<void(const MealPlan&, bool)>>& listeners() {
+        static vector<function<void(const MealPlan&, bool)>> hooks;
+        return hooks;
+    }
+
+    static void notifyChange(const MealPlan& entry, bool removed) {
+        vector<function<void(const MealPlan&, bool)>>& hooks = listeners();
+        for (int i = 0; i < hooks.size(); i++) hooks[i](entry, removed);
+    }
+
+    // canonical week: "YYYY-Www" for ISO labels, the label itself otherwise
+    static string weekKey(string w) {
+        int y = 0; int wk = 0;
+        if (Dates::parseWeek(w, y, wk)) { return Dates::formatWeek(y, wk); }
+        return w;
+    }
+
+    // partition holding a week: its ISO label, or OTHER
+    static string partitionOf(string w) {
+        int y = 0; int wk = 0;
+        if (Dates::parseWeek(w, y, wk)) { return Dates::formatWeek(y, wk); }
+        return OTHER;
+    }
+
+    // 0 = Mon .. 6 = Sun, 7 for any other label
+    static int dayIndex(string d) {
+        static const string names[7] = {"mon","tue","wed","thu","fri","sat","sun"};
+        string lower = out.toLowerCase(out.trim(d));
+        for (int i = 0; i < 7; i++) {
+            if (lower.compare(0, 3, names[i]) == 0) { return i; }
+        }
+        return 7;
+    }
+
+private:
+    static constexpr const char* OTHER = "other";   // partition for non-ISO week labels
+
+    // partition files under ./data/mealplan/ plus the id counter
+    struct Store {
+        set<string> weeks;                          // ISO partitions present, sorted = calendar order
+        bool other = false;                         // other.csv present
+        int maxId = 0;                              // largest id handed out
+        bool loaded = false;
+
+        static string folder() { return "mealplan/"; }
+
+        void load() {
+            if (loaded) { return; }
+            loaded = true;
+            weeks.clear(); other = false;
+            error_code ec;
+            filesystem::create_directories("./data/" + folder(), ec);     // on failure: no partitions, writes report it
+            for (auto& file : filesystem::directory_iterator("./data/" + folder(), ec)) {
+                string name = file.path().stem().string();
+                if (file.path().extension() != ".csv") { continue; }
+                if (name == OTHER) { other = true; }
+                else if (partitionOf(name) == name) { weeks.insert(name); }
+            }
+
+            maxId = 0;                              // recovered from the partitions, scanned once
+            vector<MealPlan> all = loadAll();
+            for (int i = 0; i < all.size(); i++) { if (all[i].id > maxId) { maxId = all[i].id; } }
+            migrateLegacy();
+        }
+
+        // split an old single-file mealplan.csv into partitions (once)
+        void migrateLegacy() {
+            error_code ec;
+            if (!filesystem::exists("./data/mealplan.csv", ec)) { return; }
+            vector<vector<string>> data = CSV("mealplan.csv").read();
+            map<string, vector<vector<string>>> parts;
+            for (int i = 0; i < data.size(); i++) {
+                if (data[i].size() < 4) { continue; }
+                int val = 0; try { val = stoi(data[i][0]); } catch (...) { val = 0; }
+                if (val > maxId) { maxId = val; }
+                parts[partitionOf(data[i][1])].push_back(data[i]);
+            }
+            for (auto& part : parts) {
+                vector<vector<string>> rows = read(part.first);
+                rows.insert(rows.end(), part.second.begin(), part.second.end());
+                if (!write(part.first, rows)) { out.coutln("Error: Could not migrate meal plan."); return; }
+            }
+            filesystem::remove("./data/mealplan.csv.bak", ec);
+            filesystem::rename("./data/mealplan.csv", "./data/mealplan.csv.bak", ec);
+            if (!data.empty()) { out.coutln("Meal plan moved to weekly files (" + to_string(parts.size()) + " partition(s))."); }
+        }
+
+        vector<vector<string>> read(string part) {
+            if (part == OTHER ? !other : !weeks.count(part)) { return {}; }   // no file, no read
+            return CSV(folder() + part + ".csv").read();
+        }
+
+        // rows kept sorted by (day, week label); an emptied partition is removed
+        bool write(string part, vector<vector<string>> rows) {
+            string path = "./data/" + folder() + part + ".csv";
+            if (rows.empty()) {
+                error_code ec;
+                filesystem::remove(path, ec);
+                if (part == OTHER) { other = false; } else { weeks.erase(part); }
+                return !ec;
             }
-            filtered.push_back(data[i]);
+            stable_sort(rows.begin(), rows.end(), [](const vector<string>& a, const vector<string>& b) {
+                int da = a.size() >= 3 ? dayIndex(a[2]) : 7; int db = b.size() >= 3 ? dayIndex(b[2]) : 7;
+                if (da != db) { return da < db; }
+                return (a.size() >= 2 ? a[1] : "") < (b.size() >= 2 ? b[1] : "");
+            });
+            if (!CSV(folder() + part + ".csv").write(rows)) { return false; }
+            if (part == OTHER) { other = true; } else { weeks.insert(part); }
+            return true;
         }
-        csv.write(filtered);
+
+        // append a partition's entries (only label `week` when given)
+        void collect(string part, string week, vector<MealPlan>& items) {
+            vector<vector<string>> data = read(part);
+            for (int i = 0; i < data.size(); i++) {
+                if (data[i].size() < 4) { continue; }
+                if (week != "" && data[i][1] != week) { continue; }
+                items.push_back(fromCSVRow(data[i]));
+            }
+        }
+    };
+
+    static Store& store() {
+        static Store table;
+        return table;
     }
 };
 
@@ -2,6 +2,9 @@
 #include "../../vendor/base/page.h"
 #include "generatemealplan.cpp"
 #include "viewmealplan.cpp"
+#include "forecastdemand.cpp"
+#include "bulkgenerate.cpp"
+#include "assemblekits.cpp"
 
 using namespace std;
 
@@ -9,10 +12,13 @@ using namespace std;
     MealPlannerPage Class
 
     Entry page for Meal Planner.
-    Provides options to generate and view weekly plans.
+    Provides options to generate and view weekly plans, to plan many weeks
+    at once, to forecast ingredient demand across weeks and to build the
+    pick list for a batch of meal kits.
 
     How it works:
-        - Shows two options: Generate and View
+        - Shows five options: Generate, View, Forecast Demand, Bulk Generate
+          and Assemble Kits
         - Navigates to the corresponding modal/page
 
     Header classes:
@@ -20,6 +26,9 @@ using namespace std;
     #include "../../vendor/base/page.h"
     #include "generatemealplan.cpp"
     #include "viewmealplan.cpp"
+    #include "forecastdemand.cpp"
+    #include "bulkgenerate.cpp"
+    #include "assemblekits.cpp"
 
     MealPlannerPage:
         protected:
@@ -36,6 +45,13 @@ protected:
         // no additional content to display
     }
 
+    /*
+        Menu only - the frame never changes
+    */
+    unsigned long long dataVersion() override {
+        return 1;
+    }
+
 public:
     MealPlannerPage() : Page() {
         this->header = "Meal Planner";
@@ -43,10 +59,19 @@ public:
         this->useExitInsteadOfBack = false;
         this->options = {
             Options("Generate", [this]() {
-                GenerateMealPlanModal modal; modal.init();
+                Navigator::shared().open(new GenerateMealPlanModal());
             }),
             Options("View", [this]() {
-                ViewMealPlanPage page; page.init();
+                Navigator::shared().open(new ViewMealPlanPage());
+            }),
+            Options("Forecast Demand", [this]() {
+                Navigator::shared().open(new ForecastDemandModal());
+            }),
+            Options("Bulk Generate", [this]() {
+                Navigator::shared().open(new BulkGenerateModal());
+            }),
+            Options("Assemble Kits", [this]() {
+                Navigator::shared().open(new AssembleKitsModal());
             })
         };
     }
@@ -13,7 +13,8 @@ using namespace std;
     How it works:
         - Ask for week label
         - Load entries for that week
-        - Display in a simple list
+        - Display in a simple list (recipe names come from the cached
+          MealPlan::nameOf() lookup, so renamed recipes show their new name)
 
     Header classes:
     #include "../../vendor/sys/out.h"
@@ -43,7 +44,7 @@ protected:
         out.br();
         for (int i = 0; i < items.size(); i++) {
             MealPlan it = items[i];
-            out.coutln("- " + it.day + ": " + it.recipeName + " (Recipe ID: " + to_string(it.recipeId) + ")");
+            out.coutln("- " + it.day + ": " + it.recipeName() + " (Recipe ID: " + to_string(it.recipeId) + ")");
         }
         out.br();
     }
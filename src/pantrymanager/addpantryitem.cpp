@@ -1,5 +1,6 @@
 #include "../../vendor/sys/out.h"
 #include "../../vendor/base/modal.h"
+#include "../../vendor/sys/dates.h"
 #include "pantry.cpp"
 
 using namespace std;
@@ -11,7 +12,8 @@ using namespace std;
     It collects ingredient data, displays a preview, and allows editing before saving.
 
     How it works:
-        - Collects ingredient name, quantity, and unit from user
+        - Collects ingredient name, quantity, unit and optional expiry date from user
+        - A dated amount is stored as an expiry lot (see PantryLots)
         - Displays a preview of the ingredient
         - Asks for confirmation (y/n)
         - If not confirmed, allows editing specific fields
@@ -21,12 +23,14 @@ using namespace std;
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/base/modal.h"
+    #include "../../vendor/sys/dates.h"
     #include "pantry.cpp"
 
     AddPantryItemModal:
         private:
             - item                      : Pantry object being created
             - collectItemData()         : Prompts user for ingredient information
+            - collectExpiry()           : Prompts for an optional expiry date
             - confirmItem()             : Shows preview and asks for confirmation
             - changeItem()              : Allows editing specific ingredient fields
         protected:
@@ -45,11 +49,24 @@ private:
         out.hr();                                   // horizontal rule
         out.br();
         item.name = out.inputs("Enter ingredient name: ");      // prompt for name
-        item.quantity = out.inputs("Enter quantity: ");         // prompt for quantity
+        item.quantity = out.inputd("Enter quantity: ");         // prompt for quantity
         item.unit = out.inputs("Enter unit (cups, g, tsp, etc): ");    // prompt for unit
+        collectExpiry();                                        // prompt for expiry
         out.br();
     }
 
+    /*
+        Prompt for an expiry date (blank for none)
+    */
+    void collectExpiry() {
+        while (true) {
+            string text = out.trim(out.inputs("Expiry date (YYYY-MM-DD, blank if none): "));
+            if (text == "") { item.expiry = Dates::NONE; return; }     // undated stock
+            if (Dates::parse(text, item.expiry)) { return; }           // valid date
+            out.coutln("Invalid date. Use YYYY-MM-DD.");
+        }
+    }
+
     /*
         Display ingredient preview and ask for confirmation
     */
@@ -68,7 +85,8 @@ private:
         out.coutln("1. Ingredient name");
         out.coutln("2. Quantity");
         out.coutln("3. Unit");
-        out.coutln("4. None");
+        out.coutln("4. Expiry date");
+        out.coutln("5. None");
         int choice = out.inputi("Enter your choice: ");     // get user choice
         out.br();
 
@@ -79,7 +97,7 @@ private:
                 out.br();
                 break;
             case 2:
-                item.quantity = out.inputs("Quantity: ");   // edit quantity
+                item.quantity = out.inputd("Quantity: ");   // edit quantity
                 out.coutln("Quantity changed successfully!");
                 out.br();
                 break;
@@ -89,6 +107,11 @@ private:
                 out.br();
                 break;
             case 4:
+                collectExpiry();                    // edit expiry
+                out.coutln("Expiry date changed successfully!");
+                out.br();
+                break;
+            case 5:
                 return;                             // no changes
             default:
                 out.coutln("Invalid choice!");      // invalid input
@@ -0,0 +1,77 @@
+#include "../../vendor/sys/out.h"
+#include "../../vendor/base/modal.h"
+#include "../../vendor/sys/dates.h"
+#include "pantry.cpp"
+#include "pantrylots.cpp"
+
+using namespace std;
+
+/*
+    ExpiringPantryModal Class
+
+    This modal lists pantry stock that expires soon, so it can be used
+    before it goes bad.
+
+    How it works:
+        - Prompts for a number of days (e.g. 3)
+        - Reads the lots expiring from any past date up to today + days out
+          of the PantryLots expiry calendar (one ordered seek, no table scan);
+          a huge number of days is capped at 9999-12-31, the last date a
+          lot can carry
+        - Shows each lot with its ingredient, amount and date, marking lots
+          that already expired
+        - Automatically returns to parent page after completion
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/base/modal.h"
+    #include "../../vendor/sys/dates.h"
+    #include "pantry.cpp"
+    #include "pantrylots.cpp"
+
+    ExpiringPantryModal:
+        protected:
+            - schema()                  : Main modal logic (override from Modal)
+        public:
+            - ExpiringPantryModal()     : Constructor
+*/
+class ExpiringPantryModal : public Modal {
+protected:
+    /*
+        Main modal schema - List lots expiring soon
+    */
+    void schema() override {
+        out.hr();                                   // horizontal rule
+        out.br();
+
+        int days = out.inputi("Show items expiring within how many days? ");   // prompt for window
+        if (days < 0) { days = 0; }                 // today only
+        int today = Dates::today();
+        int last = Dates::fromCivil(9999, 12, 31);  // latest date parse() accepts
+        int until = int(min<long long>((long long)today + days, last));     // no int overflow, below NONE
+        vector<PantryLot> lots = PantryLots::shared().expiringBetween(-Dates::NONE, until);    // calendar range
+        out.br();
+
+        if (lots.size() == 0) {                     // nothing expiring
+            out.coutln("Nothing expires by " + Dates::format(until) + ".");
+            out.br();
+            return;                                 // exit modal
+        }
+
+        out.coutln("Expiring by " + Dates::format(until) + " (" + to_string(lots.size()) + " lot(s)):");
+        out.br();
+        for (int i = 0; i < lots.size(); i++) {
+            Pantry item = Pantry::findById(lots[i].pantryId);   // owning ingredient
+            string line = to_string(i + 1) + ". " + Dates::format(lots[i].expiry) + " - " + item.name + " - " + out.formatNumber(lots[i].quantity) + " " + item.unit;
+            if (lots[i].expiry < today) { line += " (expired)"; }   // already past
+            out.coutln(line);                       // display lot
+        }
+        out.br();
+    }
+
+public:
+    /*
+        Constructor
+    */
+    ExpiringPantryModal() : Modal() {}              // default constructor
+};
@@ -3,11 +3,19 @@
 
 #include "../../vendor/sys/out.h"
 #include "../../vendor/sys/csv.h"
+#include "../../vendor/sys/units.h"
+#include "../../vendor/sys/dates.h"
+#include "pantrylots.cpp"
+#include "pantryhistory.cpp"
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <functional>
 
 using namespace std;
 
+struct PantryBatch;                                 // bulk changes (pantrybatch.cpp)
+
 /*
     Pantry Struct
 
@@ -19,17 +27,35 @@ using namespace std;
         - The struct provides CSV conversion methods for persistence
         - Static methods handle loading all ingredients and finding by id
         - Instance methods handle saving and updating quantities
+        - pantry.csv is read once into an in-memory Store with hash indexes
+          (case-folded name -> row, id -> row); lookups and upserts are O(1)
+          and every change is persisted with a single write
+        - PantryBatch (friend) applies many changes to the Store with one write
+        - Dated stock is tracked as PantryLots: saving with an expiry adds a
+          lot, lowering a quantity uses lots first-expired-first-out, and
+          deleting an ingredient drops its lots
+        - Every change is also recorded in PantryHistory (append-only log
+          with snapshots), flushed by the same persist() that writes
+          pantry.csv; an empty pantry.csv is rebuilt from that history
+        - listeners() are told about every changed row once the write that
+          contains it succeeded (rows as stored, removed=true for deletes),
+          so caches built from the pantry can update just those rows
 
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/sys/csv.h"
+    #include "../../vendor/sys/units.h"
+    #include "../../vendor/sys/dates.h"
+    #include "pantrylots.cpp"
+    #include "pantryhistory.cpp"
 
     Pantry:
         public:
             - id                        : Unique ingredient id (1-based)
             - name                      : Ingredient name
-            - quantity                  : Quantity value
+            - quantity                  : Quantity value (number, shortest form in CSV)
             - unit                      : Unit of measurement (cups, g, tsp, etc)
+            - expiry                    : Expiry of the amount being saved (lot, not in pantry.csv)
             - displayPreview()          : Display ingredient with formatted box
             - toCSVRow()                : Convert ingredient to CSV row format
             - fromCSVRow()              : Create Pantry from CSV row (static)
@@ -39,20 +65,29 @@ using namespace std;
             - findByName()              : Find and return ingredient by name (static)
             - deleteById()              : Delete ingredient by id from CSV (static)
             - updateQuantity()          : Update ingredient quantity in CSV
+            - listeners()               : Callbacks run for each persisted row change (static)
+        private:
+            - Store                     : In-memory rows with name/id hash indexes
+            - store()                   : Shared Store instance (static)
+            - fold()                    : Case-folded lookup key (static)
+            - saveLot()                 : Record saved amount as an expiry lot
+            - logChange()               : Queue a PantryHistory event and listener call (static)
+            - notifyChanges()           : Run listeners for the persisted changes (static)
 */
 struct Pantry {
 public:
     int id;
     string name;
-    string quantity;
+    double quantity;
     string unit;
+    int expiry = Dates::NONE;                       // expiry of the amount being saved
 
-    Pantry() { id = 0; }                            // default constructor
+    Pantry() { id = 0; quantity = 0.0; }            // default constructor
 
-    Pantry(string n, string q, string u)
+    Pantry(string n, double q, string u)
         : name(n), quantity(q), unit(u) { id = 0; } // constructor with name, quantity, unit
 
-    Pantry(int i, string n, string q, string u)
+    Pantry(int i, string n, double q, string u)
         : id(i), name(n), quantity(q), unit(u) {}   // constructor with all fields
 
     /*
@@ -65,7 +100,10 @@ public:
             out.coutln("ID: " + to_string(id));     // display id
         }
         out.coutln("Ingredient: " + name);          // display name
-        out.coutln("Quantity: " + quantity + " " + unit);   // display quantity with unit
+        out.coutln("Quantity: " + out.formatNumber(quantity) + " " + unit);    // display quantity with unit
+        if (expiry != Dates::NONE) {                // if expiry is set
+            out.coutln("Expires: " + Dates::format(expiry));    // display expiry date
+        }
         out.br();
         out.coutln("+-----------------------------------------+");
         out.br();
@@ -78,7 +116,7 @@ public:
         vector<string> row;
         row.push_back(to_string(id));               // add id to row
         row.push_back(name);                        // add name to row
-        row.push_back(quantity);                    // add quantity to row
+        row.push_back(out.formatNumber(quantity));  // add quantity to row (shortest form)
         row.push_back(unit);                        // add unit to row
         return row;                                 // return csv row
     }
@@ -97,7 +135,7 @@ public:
             }
             item.id = parsedId;                     // set id
             item.name = row[1];                     // set name
-            item.quantity = row[2];                 // set quantity
+            if (!out.parseNumber(row[2], item.quantity)) item.quantity = 0.0;  // parse quantity once
             item.unit = row[3];                     // set unit
         }
         return item;                                // return pantry item
@@ -105,37 +143,29 @@ public:
 
     /*
         Save ingredient to CSV file
-        If ingredient already exists, adds to existing quantity instead of creating duplicate
+        If ingredient already exists, adds to existing quantity (converted to its unit) instead of creating duplicate
+        If expiry is set, the saved amount is also recorded as a lot
     */
     void save() {
-        CSV csv("pantry.csv");                      // create csv object
-        vector<vector<string>> data = csv.read();   // read existing data
-
-        Pantry existing = findByName(name);         // check for duplicate
-        if (existing.id > 0) {                      // duplicate found
-            double existingQty = 0.0;
-            double newQty = 0.0;
-            
-            try { existingQty = stod(existing.quantity); } catch (...) { existingQty = 0.0; }  // parse existing quantity
-            try { newQty = stod(quantity); } catch (...) { newQty = 0.0; }                     // parse new quantity
-            
-            double totalQty = existingQty + newQty; // add quantities
-            string totalQtyStr = to_string(totalQty);   // convert to string
-            
-            for (int i = 0; i < data.size(); i++) {
-                if (data[i].size() >= 4) {          // valid row
-                    int rowId = 0;
-                    try { rowId = stoi(data[i][0]); } catch (...) { rowId = 0; }   // parse row id
-                    if (rowId == existing.id) {     // found matching row
-                        data[i][2] = totalQtyStr;   // update quantity
-                        break;                      // exit loop
-                    }
-                }
+        Store& table = store();                     // indexed pantry rows
+        table.load();                               // read pantry.csv once per session
+
+        auto hit = table.byName.find(fold(name));   // O(1) duplicate check
+        if (hit != table.byName.end()) {            // duplicate found
+            Pantry& existing = table.rows[hit->second];
+            double previousQty = existing.quantity;
+            double added = quantity;
+            if (!Units::convert(quantity, unit, existing.unit, name, added)) {   // into the stored unit
+                added = quantity;                   // not convertible: add as-is
+                out.coutln("Warning: cannot convert " + unit + " to " + existing.unit + ", adding the amount unchanged.");
             }
-            
-            if (csv.write(data)) {                  // write updated data
+            existing.quantity += added;             // merge in memory
+            logChange("add", existing, added);      // history event
+
+            if (table.persist()) {                  // single write
                 out.coutln("Ingredient '" + name + "' already exists!");
-                out.coutln("Updated quantity from " + existing.quantity + " " + existing.unit + " to " + totalQtyStr + " " + existing.unit);
+                out.coutln("Updated quantity from " + out.formatNumber(previousQty) + " " + existing.unit + " to " + out.formatNumber(existing.quantity) + " " + existing.unit);
+                if (!saveLot(existing.id, added)) out.coutln("Warning: Could not save the expiry date.");
             } else {
                 out.coutln("Error: Could not update ingredient.");
             }
@@ -143,20 +173,15 @@ public:
             return;                                 // exit method
         }
 
-        int maxId = 0;                              // find max id for auto-increment
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i].size() >= 1) {              // valid row
-                int parsed = 0;
-                try { parsed = stoi(data[i][0]); } catch (...) { parsed = 0; }     // parse id
-                if (parsed > maxId) { maxId = parsed; }     // update max id
-            }
-        }
-        id = maxId + 1;                             // set new id
-
-        data.push_back(toCSVRow());                 // add new row
+        id = table.maxId + 1;                       // set new id
+        Pantry row = *this;
+        row.expiry = Dates::NONE;                   // expiry lives in the lot, not the row
+        table.insert(row);                          // add row and index it
+        logChange("add", row, quantity);            // history event
 
-        if (csv.write(data)) {                      // write to file
+        if (table.persist()) {                      // write to file
             out.coutln("Ingredient '" + name + "' added successfully!");
+            if (!saveLot(id, quantity)) out.coutln("Warning: Could not save the expiry date.");
         } else {
             out.coutln("Error: Could not save ingredient.");
         }
@@ -167,118 +192,208 @@ public:
         Load all ingredients from CSV file
     */
     static vector<Pantry> loadAll() {
-        vector<Pantry> items;                       // create empty vector
-        CSV csv("pantry.csv");                      // create csv object
-        vector<vector<string>> data = csv.read();   // read csv data
-
-        for (int i = 0; i < data.size(); i++) {
-            if (!data[i].empty()) {                 // valid row
-                items.push_back(fromCSVRow(data[i]));   // convert and add to items
-            }
-        }
-
-        return items;                               // return all items
+        Store& table = store();
+        table.load();                               // read pantry.csv once per session
+        return table.rows;                          // return all items
     }
 
     /*
         Find and return ingredient by id
     */
     static Pantry findById(int rid) {
-        vector<Pantry> all = loadAll();             // load all ingredients
-        for (int i = 0; i < all.size(); i++) {
-            if (all[i].id == rid) {                 // match found
-                return all[i];                      // return ingredient
-            }
-        }
-        return Pantry();                            // return empty if not found
+        Store& table = store();
+        table.load();
+        auto hit = table.byId.find(rid);            // hash lookup
+        if (hit == table.byId.end()) return Pantry();   // return empty if not found
+        return table.rows[hit->second];             // return ingredient
     }
 
     /*
         Find and return ingredient by name (case-insensitive)
     */
     static Pantry findByName(string searchName) {
-        vector<Pantry> all = loadAll();             // load all ingredients
-        
-        string lowerSearchName = searchName;        // create lowercase copy
-        for (int i = 0; i < lowerSearchName.length(); i++) {
-            lowerSearchName[i] = tolower(lowerSearchName[i]);   // convert to lowercase
-        }
-        
-        for (int i = 0; i < all.size(); i++) {
-            string lowerItemName = all[i].name;     // create lowercase copy
-            for (int j = 0; j < lowerItemName.length(); j++) {
-                lowerItemName[j] = tolower(lowerItemName[j]);   // convert to lowercase
-            }
-            
-            if (lowerItemName == lowerSearchName) { // match found
-                return all[i];                      // return ingredient
-            }
-        }
-        return Pantry();                            // return empty if not found
+        Store& table = store();
+        table.load();
+        auto hit = table.byName.find(fold(searchName));     // hash lookup on folded name
+        if (hit == table.byName.end()) return Pantry();     // return empty if not found
+        return table.rows[hit->second];             // return ingredient
     }
 
     /*
         Delete ingredient by id from CSV file
     */
     static bool deleteById(int id) {
-        CSV csv("pantry.csv");                      // create csv object
-        vector<vector<string>> data = csv.read();   // read existing data
-        vector<vector<string>> newData;             // create new data vector
-        bool found = false;
-
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i].size() >= 4) {              // valid row
-                int rowId = 0;
-                try {
-                    rowId = stoi(data[i][0]);       // parse row id
-                } catch (...) {
-                    rowId = 0;                      // default to 0 if parse fails
-                }
-                if (rowId == id) {                  // match found
-                    found = true;                   // mark as found
-                    continue;                       // skip adding to newData
-                }
-            }
-            newData.push_back(data[i]);             // add row to new data
-        }
+        Store& table = store();
+        table.load();
+        auto hit = table.byId.find(id);
+        if (hit == table.byId.end()) return false;  // not found
 
-        if (found) {                                // ingredient was found and removed
-            csv.write(newData);                     // write updated data
-            return true;                            // success
-        }
-        return false;                               // not found
+        Pantry removed = table.rows[hit->second];
+        removed.quantity = 0.0;
+        logChange("delete", removed, -table.rows[hit->second].quantity);   // history event
+        table.rows.erase(table.rows.begin() + hit->second);     // keep file order
+        table.reindex();                            // row positions shifted
+        if (!table.persist()) return false;         // write failed: lots untouched
+
+        PantryLots& lots = PantryLots::shared();
+        lots.removeIngredient(id);                  // dated stock goes with the row
+        lots.persist();
+        return true;                                // success
     }
 
     /*
         Update ingredient quantity in CSV file
+            - a lower quantity is taken from lots first-expired-first-out
+    */
+    bool updateQuantity(double newQuantity) {
+        Store& table = store();
+        table.load();
+        auto hit = table.byId.find(id);
+        if (hit == table.byId.end()) return false;  // not found
+
+        double previous = table.rows[hit->second].quantity;
+        table.rows[hit->second].quantity = newQuantity;     // update stored row
+        quantity = newQuantity;                     // update object quantity
+        logChange("adjust", table.rows[hit->second], newQuantity - previous);  // history event
+        if (!table.persist()) return false;         // write failed: lots untouched
+
+        PantryLots& lots = PantryLots::shared();
+        if (newQuantity < previous) { lots.consume(id, previous - newQuantity); }  // FEFO
+        lots.trimTo(id, newQuantity);               // lots never exceed the row
+        lots.persist();
+        return true;                                // success
+    }
+
+    /*
+        Callbacks run for each row change after pantry.csv was written
+            - (row as stored, removed)
+    */
+    static vector<function<void(const Pantry&, bool)>>& listeners() {
+        static vector<function<void(const Pantry&, bool)>> hooks;  // registered callbacks
+        return hooks;
+    }
+
+private:
+    friend struct PantryBatch;                      // applies deltas to the Store directly
+
+    /*
+        Queue a history event for a row (written by the next persist)
     */
-    bool updateQuantity(string newQuantity) {
-        CSV csv("pantry.csv");                      // create csv object
-        vector<vector<string>> data = csv.read();   // read existing data
-        bool found = false;
-
-        for (int i = 0; i < data.size(); i++) {
-            if (data[i].size() >= 4) {              // valid row
-                int rowId = 0;
-                try {
-                    rowId = stoi(data[i][0]);       // parse row id
-                } catch (...) {
-                    rowId = 0;                      // default to 0 if parse fails
+    static void logChange(string type, const Pantry& row, double delta) {
+        PantryHistory::shared().record(type, row.id, row.name, delta, row.quantity, row.unit);
+        store().changed.push_back({ row, type == "delete" });  // told to listeners after the write
+    }
+
+    /*
+        Run listeners for the changes kept by the last write
+    */
+    static void notifyChanges(vector<pair<Pantry, bool>> changes) {
+        vector<function<void(const Pantry&, bool)>>& hooks = listeners();
+        for (size_t i = 0; i < changes.size(); i++) {
+            for (size_t j = 0; j < hooks.size(); j++) hooks[j](changes[i].first, changes[i].second);
+        }
+    }
+
+    /*
+        Record the saved amount as a dated lot (no-op without expiry)
+    */
+    bool saveLot(int pantryId, double amount) {
+        if (expiry == Dates::NONE) return true;     // undated stock
+        PantryLots& lots = PantryLots::shared();
+        lots.add(pantryId, amount, expiry);
+        return lots.persist();                      // single write
+    }
+
+    /*
+        In-memory pantry table with hash indexes
+            - rows keep pantry.csv order
+            - byName maps folded (lowercase) names to row positions
+            - byId maps ids to row positions
+    */
+    struct Store {
+        vector<Pantry> rows;                        // pantry rows in file order
+        unordered_map<string, size_t> byName;       // folded name -> row
+        unordered_map<int, size_t> byId;            // id -> row
+        int maxId = 0;                              // largest id seen
+        bool loaded = false;                        // rows mirror pantry.csv
+        vector<pair<Pantry, bool>> changed;         // rows changed since the last write
+
+        void load() {
+            if (loaded) return;                     // already in memory
+            CSV csv("pantry.csv");                  // create csv object
+            vector<vector<string>> data = csv.read();   // single read
+            rows.clear();
+            for (int i = 0; i < data.size(); i++) {
+                if (!data[i].empty()) {             // valid row
+                    rows.push_back(fromCSVRow(data[i]));    // convert and add to rows
                 }
-                if (rowId == id) {                  // match found
-                    data[i][2] = newQuantity;       // update quantity in data
-                    quantity = newQuantity;         // update object quantity
-                    found = true;                   // mark as found
-                    break;                          // exit loop
+            }
+            reindex();
+            loaded = true;
+
+            PantryHistory& history = PantryHistory::shared();
+            map<int, PantryHistory::Level> levels;
+            for (size_t i = 0; i < rows.size(); i++) {
+                levels[rows[i].id] = { rows[i].name, rows[i].quantity, rows[i].unit };
+            }
+            history.baseline(levels);               // first use: snapshot existing pantry
+            if (rows.empty() && !history.current().empty()) {   // pantry.csv lost or emptied outside the app
+                for (auto& entry : history.current()) {
+                    rows.push_back(Pantry(entry.first, entry.second.name, entry.second.quantity, entry.second.unit));
                 }
+                reindex();
+                if (persist()) { out.coutln("Pantry restored from history (" + to_string(rows.size()) + " item(s))."); }
             }
         }
 
-        if (found) {                                // ingredient was found and updated
-            csv.write(data);                        // write updated data
-            return true;                            // success
+        void reindex() {
+            byName.clear();
+            byId.clear();
+            maxId = 0;
+            for (size_t i = 0; i < rows.size(); i++) {
+                byName.emplace(fold(rows[i].name), i);  // first row wins on duplicates
+                byId[rows[i].id] = i;
+                if (rows[i].id > maxId) { maxId = rows[i].id; }
+            }
+        }
+
+        void insert(const Pantry& item) {
+            rows.push_back(item);
+            byName.emplace(fold(item.name), rows.size() - 1);
+            byId[item.id] = rows.size() - 1;
+            if (item.id > maxId) { maxId = item.id; }
+        }
+
+        bool persist() {
+            vector<vector<string>> data;
+            data.reserve(rows.size());
+            for (size_t i = 0; i < rows.size(); i++) {
+                data.push_back(rows[i].toCSVRow()); // serialize every row
+            }
+            CSV csv("pantry.csv");
+            vector<pair<Pantry, bool>> done;
+            done.swap(changed);
+            if (csv.write(data)) {                  // single write
+                PantryHistory::shared().flush();    // single history append
+                notifyChanges(done);
+                return true;
+            }
+            PantryHistory::shared().discard();      // changes were not kept
+            loaded = false;                         // reload from disk next time
+            return false;
         }
-        return false;                               // not found
+    };
+
+    static Store& store() {
+        static Store table;                         // shared by every Pantry call
+        return table;
+    }
+
+    /*
+        Case-folded lookup key for a name
+    */
+    static string fold(string text) {
+        return out.toLowerCase(text);
     }
 };
 
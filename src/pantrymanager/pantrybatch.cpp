@@ -0,0 +1,159 @@
+#ifndef PANTRYBATCH_H                           // for no dup def
+#define PANTRYBATCH_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/units.h"
+#include "../../vendor/sys/dates.h"
+#include "pantry.cpp"
+#include "pantrylots.cpp"
+#include <vector>
+#include <string>
+
+using namespace std;
+
+/*
+    PantryBatch Struct
+
+    This struct collects many pantry changes and applies them as one
+    transaction, so bulk operations (syncing a grocery list) read and write
+    pantry.csv once instead of once or twice per item.
+
+    How it works:
+        - add(), subtract() and set() only queue a Delta; nothing is read or
+          written until commit()
+        - commit() loads the Pantry store once, applies every delta in order
+          against its name index (case-insensitive), then persists with a
+          single write
+        - Quantities are converted into the stored row's unit (Units); a
+          delta whose unit cannot be converted is applied unchanged and
+          counted in `unconverted`
+        - add/set on a missing ingredient creates a row; subtract on a
+          missing ingredient is skipped; subtract never goes below zero
+        - Dated stock follows the pantry rows: add() with an expiry creates a
+          lot, subtract() and a lowering set() use lots first-expired-first-
+          out (PantryLots); pantry_lots.csv is also written once per commit
+        - Each applied delta is a PantryHistory event (add, consume, adjust),
+          appended in one write when pantry.csv is persisted
+        - If the pantry.csv write fails the store reloads pantry.csv and the
+          lots reload pantry_lots.csv on next use (the lots file is not
+          written), so a failed commit leaves no partial changes behind
+        - commit() reports the pantry.csv write; lotsSaved reports the
+          pantry_lots.csv write separately, so a caller can tell "nothing
+          was written" from "stock saved, expiry lots not saved"
+        - The queue is cleared after commit(); counters describe the last commit
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/units.h"
+    #include "../../vendor/sys/dates.h"
+    #include "pantry.cpp"
+    #include "pantrylots.cpp"
+
+    PantryBatch:
+        public:
+            - Op                        : ADD, SUBTRACT or SET
+            - Delta                     : One queued change
+            - created / updated         : Rows added / deltas merged by the last commit
+            - skipped / unconverted     : Deltas ignored / applied without unit conversion
+            - lotsSaved                 : pantry_lots.csv written by the last commit
+            - add(name, quantity, unit, expiry) : Queue an increase (optional lot expiry)
+            - subtract(name, quantity, unit) : Queue a decrease
+            - set(name, quantity, unit)      : Queue an absolute quantity
+            - size()                    : Number of queued deltas
+            - clear()                   : Drop queued deltas
+            - commit()                  : Apply all deltas with one write (true when pantry.csv was written)
+        private:
+            - deltas                    : Queued changes in call order
+            - apply(table, lots, delta) : Apply one delta to the store and lots
+*/
+struct PantryBatch {
+public:
+    enum Op { ADD, SUBTRACT, SET };
+
+    struct Delta {
+        Op op;
+        string name;
+        double quantity;
+        string unit;
+        int expiry;                                 // lot expiry for ADD (Dates::NONE if undated)
+    };
+
+    int created = 0;                                // rows created by last commit
+    int updated = 0;                                // deltas merged by last commit
+    int skipped = 0;                                // subtracts on missing rows
+    int unconverted = 0;                            // unit mismatches applied as-is
+    bool lotsSaved = true;                          // pantry_lots.csv written by last commit
+
+    void add(string name, double quantity, string unit, int expiry = Dates::NONE) { deltas.push_back({ ADD, name, quantity, unit, expiry }); }
+    void subtract(string name, double quantity, string unit) { deltas.push_back({ SUBTRACT, name, quantity, unit, Dates::NONE }); }
+    void set(string name, double quantity, string unit) { deltas.push_back({ SET, name, quantity, unit, Dates::NONE }); }
+
+    size_t size() { return deltas.size(); }
+    void clear() { deltas.clear(); }
+
+    /*
+        Apply every queued delta and write pantry.csv once
+    */
+    bool commit() {
+        created = 0; updated = 0; skipped = 0; unconverted = 0; lotsSaved = true;
+        Pantry::Store& table = Pantry::store();     // indexed pantry rows
+        table.load();                               // single read (cached per session)
+        PantryLots& lots = PantryLots::shared();
+        lots.load();
+        for (int i = 0; i < deltas.size(); i++) {
+            apply(table, lots, deltas[i]);          // in-memory only
+        }
+        deltas.clear();
+        if (created == 0 && updated == 0) return true;  // nothing to write
+        if (!table.persist()) {                     // single write; nothing kept
+            lots.discard();                         // keep lots in step with pantry.csv
+            lotsSaved = false;
+            return false;
+        }
+        lotsSaved = lots.persist();                 // single lots write
+        return true;                                // pantry.csv and history written
+    }
+
+private:
+    vector<Delta> deltas;                           // queued changes
+
+    /*
+        Apply one delta to the in-memory store
+    */
+    void apply(Pantry::Store& table, PantryLots& lots, const Delta& delta) {
+        auto hit = table.byName.find(Pantry::fold(delta.name));
+        if (hit == table.byName.end()) {            // ingredient not in pantry
+            if (delta.op == SUBTRACT) { skipped++; return; }    // nothing to take from
+            int newId = table.maxId + 1;
+            Pantry row(newId, delta.name, delta.quantity, delta.unit);
+            table.insert(row);
+            Pantry::logChange(delta.op == ADD ? "add" : "adjust", row, delta.quantity);    // history event
+            if (delta.op == ADD) { lots.add(newId, delta.quantity, delta.expiry); }
+            created++;
+            return;
+        }
+
+        Pantry& row = table.rows[hit->second];
+        double amount = delta.quantity;
+        if (!Units::convert(delta.quantity, delta.unit, row.unit, delta.name, amount)) {   // into the stored unit
+            amount = delta.quantity;                // not convertible: apply as-is
+            unconverted++;
+        }
+        double previous = row.quantity;
+        if (delta.op == ADD) { row.quantity += amount; }
+        else if (delta.op == SUBTRACT) { row.quantity = row.quantity > amount ? row.quantity - amount : 0.0; }
+        else { row.quantity = amount; }
+
+        const char* types[] = { "add", "consume", "adjust" };
+        Pantry::logChange(types[delta.op], row, row.quantity - previous);  // history event
+
+        if (delta.op == ADD) { lots.add(row.id, amount, delta.expiry); }    // dated stock
+        else if (row.quantity < previous) {         // used up: soonest expiry first
+            lots.consume(row.id, previous - row.quantity);
+            lots.trimTo(row.id, row.quantity);
+        }
+        updated++;
+    }
+};
+
+#endif                                              // PANTRYBATCH_H
@@ -0,0 +1,367 @@
+#ifndef PANTRYHISTORY_H                         // for no dup def
+#define PANTRYHISTORY_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/csv.h"
+#include "../../vendor/sys/dates.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <ctime>
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+using namespace std;
+
+/*
+    PantryEvent Struct
+
+    One change to a pantry ingredient in the append-only history log.
+    Besides the change itself (delta) it records the ingredient's level
+    after the change, so replaying an event is a plain assignment.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/csv.h"
+    #include "../../vendor/sys/dates.h"
+
+    PantryEvent:
+        public:
+            - seq                       : Event number (1-based, increasing)
+            - time                      : Unix time of the change
+            - day                       : Local day number of the change (Dates)
+            - type                      : "add", "consume", "adjust" or "delete"
+            - pantryId / name / unit    : Ingredient affected
+            - delta                     : Change in quantity
+            - level                     : Quantity after the change
+            - toCSVRow()                : Convert event to CSV row format
+            - fromCSVRow()              : Create PantryEvent from CSV row (static)
+*/
+struct PantryEvent {
+public:
+    long long seq = 0;
+    long long time = 0;
+    int day = 0;
+    string type;
+    int pantryId = 0;
+    string name;
+    double delta = 0.0;
+    double level = 0.0;
+    string unit;
+
+    vector<string> toCSVRow() {
+        vector<string> row;
+        row.push_back(to_string(seq));              // add sequence number
+        row.push_back(to_string(time));             // add unix time
+        row.push_back(Dates::format(day));          // add day (YYYY-MM-DD)
+        row.push_back(type);                        // add event type
+        row.push_back(to_string(pantryId));         // add ingredient id
+        row.push_back(name);                        // add ingredient name
+        row.push_back(out.formatNumber(delta));     // add change
+        row.push_back(out.formatNumber(level));     // add level after change
+        row.push_back(unit);                        // add unit
+        return row;
+    }
+
+    static PantryEvent fromCSVRow(vector<string> row) {
+        PantryEvent e;
+        if (row.size() >= 9) {                      // check valid row format
+            try { e.seq = stoll(row[0]); } catch (...) { e.seq = 0; }
+            try { e.time = stoll(row[1]); } catch (...) { e.time = 0; }
+            if (!Dates::parse(row[2], e.day)) e.day = 0;
+            e.type = row[3];
+            try { e.pantryId = stoi(row[4]); } catch (...) { e.pantryId = 0; }
+            e.name = row[5];
+            if (!out.parseNumber(row[6], e.delta)) e.delta = 0.0;
+            if (!out.parseNumber(row[7], e.level)) e.level = 0.0;
+            e.unit = row[8];
+        }
+        return e;
+    }
+};
+
+/*
+    PantryHistory Class
+
+    Append-only history of pantry changes with periodic snapshots, used to
+    audit the pantry and to answer "what was in the pantry on date X"
+    without replaying every change ever made.
+
+    How it works:
+        - Files live in ./data/pantry_history/:
+            * snapshots.csv         : index of snapshots (number, last seq, day)
+            * snapshot_NNNNNN.csv   : full pantry levels at that snapshot
+            * events_NNNNNN.csv     : events recorded after snapshot NNNNNN
+        - The first time history is used, baseline() stores the existing
+          pantry as snapshot 0, so older installs start with correct levels.
+        - record() queues an event and applies it to the in-memory current
+          levels; flush() appends the queue to the open events file with one
+          write. After SNAPSHOT_EVERY events a new snapshot is written and a
+          new events file is started, so no log segment grows unbounded.
+        - On load, current levels are rebuilt from the latest snapshot plus
+          its events file (the log tail), never from the full history.
+        - levelsAt(day) binary-searches the snapshot index for the last
+          snapshot taken by that day, then replays only that snapshot's
+          events up to the day: at most SNAPSHOT_EVERY events.
+        - Events are never rewritten; pantry.csv remains the working copy.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/csv.h"
+    #include "../../vendor/sys/dates.h"
+
+    PantryHistory:
+        public:
+            - SNAPSHOT_EVERY            : Events between snapshots
+            - Level                     : Ingredient name, quantity and unit
+            - shared()                  : Shared instance (static)
+            - baseline(levels)          : Seed snapshot 0 if history is empty
+            - record(type, id, name, delta, level, unit) : Queue an event
+            - flush()                   : Append queued events (one write)
+            - discard()                 : Drop queued events after a failed save
+            - current()                 : Levels rebuilt from snapshot + tail
+            - levelsAt(day, levels)     : Levels at the end of a day (false before history)
+            - eventsOn(day)             : Events recorded on a day
+        private:
+            - Snapshot                  : Snapshot index entry
+            - snapshots / levels        : Snapshot index / current levels
+            - lastSeq / tailEvents      : Last event number / events since last snapshot
+            - pending                   : Events not yet appended
+            - load()                    : Read index, latest snapshot and tail once
+            - writeSnapshot()           : Snapshot current levels, start a new log file
+*/
+class PantryHistory {
+public:
+    static constexpr int SNAPSHOT_EVERY = 100;      // events per log file
+
+    struct Level {
+        string name;
+        double quantity;
+        string unit;
+    };
+
+private:
+    struct Snapshot {
+        int number;                                 // snapshot_NNNNNN.csv
+        long long seq;                              // last event included
+        int day;                                    // day it was taken
+    };
+
+    vector<Snapshot> snapshots;                     // ascending by number, seq and day
+    map<int, Level> levels;                         // current levels by pantry id
+    long long lastSeq = 0;                          // last recorded event
+    int tailEvents = 0;                             // events since last snapshot
+    vector<PantryEvent> pending;                    // queued, not yet appended
+    bool loaded = false;                            // index and tail read
+
+    PantryHistory() {}
+
+    static string folder() { return "pantry_history/"; }
+
+    static string fileName(string kind, int number) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "_%06d.csv", number);
+        return folder() + kind + buffer;
+    }
+
+    /*
+        Apply one event to a level map
+    */
+    static void apply(map<int, Level>& target, const PantryEvent& e) {
+        if (e.type == "delete") { target.erase(e.pantryId); return; }
+        target[e.pantryId] = { e.name, e.level, e.unit };
+    }
+
+    /*
+        Read one snapshot file into a level map
+    */
+    static void readSnapshot(int number, map<int, Level>& target) {
+        CSV csv(fileName("snapshot", number));
+        vector<vector<string>> data = csv.read();
+        for (int i = 0; i < data.size(); i++) {
+            if (data[i].size() < 4) continue;       // skip invalid rows
+            int id = 0; double quantity = 0.0;
+            try { id = stoi(data[i][0]); } catch (...) { continue; }
+            if (!out.parseNumber(data[i][2], quantity)) quantity = 0.0;
+            target[id] = { data[i][1], quantity, data[i][3] };
+        }
+    }
+
+    /*
+        Read snapshot index, latest snapshot and its log tail once
+    */
+    void load() {
+        if (loaded) return;
+        error_code ec;
+        filesystem::create_directories("./data/" + folder(), ec);
+        if (ec) out.coutln("Error: Could not create ./data/" + folder() + " (" + ec.message() + ").");   // writes will fail and report
+        snapshots.clear(); levels.clear(); lastSeq = 0; tailEvents = 0;
+
+        CSV index(folder() + "snapshots.csv");
+        vector<vector<string>> rows = index.read();
+        for (int i = 0; i < rows.size(); i++) {
+            if (rows[i].size() < 3) continue;       // skip invalid rows
+            Snapshot s = { 0, 0, 0 };
+            try { s.number = stoi(rows[i][0]); s.seq = stoll(rows[i][1]); } catch (...) { continue; }
+            if (!Dates::parse(rows[i][2], s.day)) continue;
+            snapshots.push_back(s);
+        }
+
+        if (!snapshots.empty()) {
+            const Snapshot& latest = snapshots.back();
+            readSnapshot(latest.number, levels);    // compact state
+            lastSeq = latest.seq;
+            CSV tail(fileName("events", latest.number));
+            vector<vector<string>> data = tail.read();
+            for (int i = 0; i < data.size(); i++) { // replay the tail only
+                PantryEvent e = PantryEvent::fromCSVRow(data[i]);
+                if (e.seq <= lastSeq) continue;     // already in the snapshot
+                apply(levels, e);
+                lastSeq = e.seq;
+                tailEvents++;
+            }
+        }
+        loaded = true;
+    }
+
+    /*
+        Snapshot current levels and start a new events file
+    */
+    bool writeSnapshot() {
+        int number = snapshots.empty() ? 0 : snapshots.back().number + 1;
+        vector<vector<string>> data;
+        for (auto& entry : levels) {
+            data.push_back({ to_string(entry.first), entry.second.name, out.formatNumber(entry.second.quantity), entry.second.unit });
+        }
+        CSV snapshot(fileName("snapshot", number));
+        if (!snapshot.write(data)) return false;    // keep logging to the old file
+        Snapshot s = { number, lastSeq, Dates::today() };
+        CSV index(folder() + "snapshots.csv");
+        if (!index.append({ { to_string(s.number), to_string(s.seq), Dates::format(s.day) } })) return false;
+        snapshots.push_back(s);
+        tailEvents = 0;
+        return true;
+    }
+
+public:
+    PantryHistory(const PantryHistory&) = delete;
+    PantryHistory& operator=(const PantryHistory&) = delete;
+
+    static PantryHistory& shared() {
+        static PantryHistory instance;              // shared by every pantry call
+        return instance;
+    }
+
+    /*
+        Seed snapshot 0 from the existing pantry when history is empty
+    */
+    void baseline(const map<int, Level>& existing) {
+        load();
+        if (!snapshots.empty()) return;             // history already started
+        levels = existing;
+        writeSnapshot();
+    }
+
+    /*
+        Queue an event and apply it to the current levels
+    */
+    void record(string type, int pantryId, string name, double delta, double level, string unit) {
+        load();
+        PantryEvent e;
+        e.seq = ++lastSeq;
+        e.time = (long long)std::time(nullptr);
+        e.day = Dates::today();
+        e.type = type; e.pantryId = pantryId; e.name = name;
+        e.delta = delta; e.level = level; e.unit = unit;
+        apply(levels, e);
+        pending.push_back(e);
+    }
+
+    /*
+        Append queued events with one write (snapshot when due)
+    */
+    bool flush() {
+        if (pending.empty()) return true;           // nothing queued
+        load();
+        if (snapshots.empty() && !writeSnapshot()) return false;  // no baseline and none written: keep queue
+        vector<vector<string>> rows;
+        for (int i = 0; i < pending.size(); i++) rows.push_back(pending[i].toCSVRow());
+        CSV tail(fileName("events", snapshots.back().number));
+        if (!tail.append(rows)) return false;       // keep queue for next flush
+        tailEvents += int(pending.size());
+        pending.clear();
+        if (tailEvents >= SNAPSHOT_EVERY) writeSnapshot();  // compact
+        return true;
+    }
+
+    /*
+        Drop queued events (their change was not saved)
+    */
+    void discard() {
+        pending.clear();
+        loaded = false;                             // rebuild levels and seq from disk next time
+    }
+
+    /*
+        Current levels (latest snapshot + log tail + queued events)
+    */
+    map<int, Level> current() {
+        load();
+        return levels;
+    }
+
+    /*
+        Levels at the end of a day
+            - false when history starts after that day
+    */
+    bool levelsAt(int day, map<int, Level>& result) {
+        load();
+        result.clear();
+        auto after = upper_bound(snapshots.begin(), snapshots.end(), day,
+                                 [](int d, const Snapshot& s) { return d < s.day; });   // O(log n)
+        if (after == snapshots.begin()) return false;   // before the first snapshot
+        const Snapshot& base = *(after - 1);
+        readSnapshot(base.number, result);
+        CSV tail(fileName("events", base.number));
+        vector<vector<string>> data = tail.read();  // at most SNAPSHOT_EVERY events
+        for (int i = 0; i < data.size(); i++) {
+            PantryEvent e = PantryEvent::fromCSVRow(data[i]);
+            if (e.seq <= base.seq) continue;        // already in the snapshot
+            if (e.day > day) break;                 // later than requested
+            apply(result, e);
+        }
+        for (int i = 0; i < pending.size(); i++) {  // not yet flushed
+            if (pending[i].seq > base.seq && pending[i].day <= day) apply(result, pending[i]);
+        }
+        return true;
+    }
+
+    /*
+        Events recorded on a day (for auditing)
+    */
+    vector<PantryEvent> eventsOn(int day) {
+        load();
+        vector<PantryEvent> result;
+        auto after = upper_bound(snapshots.begin(), snapshots.end(), day,
+                                 [](int d, const Snapshot& s) { return d < s.day; });
+        auto first = lower_bound(snapshots.begin(), snapshots.end(), day,
+                                 [](const Snapshot& s, int d) { return s.day < d; });
+        if (first != snapshots.begin()) --first;    // events of that day may precede its first snapshot
+        for (auto it = first; it != after; ++it) {  // only segments that can hold the day
+            CSV segment(fileName("events", it->number));
+            vector<vector<string>> data = segment.read();
+            for (int i = 0; i < data.size(); i++) {
+                PantryEvent e = PantryEvent::fromCSVRow(data[i]);
+                if (e.day == day) result.push_back(e);
+            }
+        }
+        for (int i = 0; i < pending.size(); i++) {
+            if (pending[i].day == day) result.push_back(pending[i]);
+        }
+        return result;
+    }
+};
+
+#endif                                              // PANTRYHISTORY_H
@@ -0,0 +1,313 @@
+#ifndef PANTRYLOTS_H                            // for no dup def
+#define PANTRYLOTS_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/csv.h"
+#include "../../vendor/sys/dates.h"
+#include <vector>
+#include <string>
+#include <set>
+#include <queue>
+#include <unordered_map>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+/*
+    PantryLot Struct
+
+    One dated batch of a pantry ingredient ("2 cups of milk expiring
+    2025-11-03"). Quantities are in the owning pantry row's unit.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/csv.h"
+    #include "../../vendor/sys/dates.h"
+
+    PantryLot:
+        public:
+            - id                        : Lot id (1-based)
+            - pantryId                  : Owning Pantry row id
+            - quantity                  : Amount left in this lot
+            - expiry                    : Expiry day number (Dates)
+            - toCSVRow()                : Convert lot to CSV row format
+            - fromCSVRow()              : Create PantryLot from CSV row (static)
+*/
+struct PantryLot {
+public:
+    int id;
+    int pantryId;
+    double quantity;
+    int expiry;
+
+    PantryLot() { id = 0; pantryId = 0; quantity = 0.0; expiry = Dates::NONE; }
+
+    PantryLot(int i, int p, double q, int e) : id(i), pantryId(p), quantity(q), expiry(e) {}
+
+    vector<string> toCSVRow() {
+        vector<string> row;
+        row.push_back(to_string(id));               // add id to row
+        row.push_back(to_string(pantryId));         // add pantry id to row
+        row.push_back(out.formatNumber(quantity));  // add quantity to row
+        row.push_back(Dates::format(expiry));       // add expiry (YYYY-MM-DD)
+        return row;
+    }
+
+    static PantryLot fromCSVRow(vector<string> row) {
+        PantryLot lot;
+        if (row.size() >= 4) {                      // check valid row format
+            try { lot.id = stoi(row[0]); } catch (...) { lot.id = 0; }
+            try { lot.pantryId = stoi(row[1]); } catch (...) { lot.pantryId = 0; }
+            if (!out.parseNumber(row[2], lot.quantity)) lot.quantity = 0.0;
+            if (!Dates::parse(row[3], lot.expiry)) lot.expiry = Dates::NONE;
+        }
+        return lot;
+    }
+};
+
+/*
+    PantryLots Class
+
+    Tracks stock lots with expiry dates for pantry ingredients so stock is
+    used first-expired-first-out (FEFO) and soon-to-expire items can be
+    listed without scanning the whole pantry.
+
+    How it works:
+        - Lots live in pantry_lots.csv and are read once per session into
+          one shared instance (shared()).
+        - Each ingredient has a min-heap of (expiry, lot id); its top is the
+          lot to use next, so FEFO consumption costs O(log n) per lot used.
+        - A global expiry calendar (ordered set of (expiry, lot id)) answers
+          "what expires between two dates" with one O(log n) seek plus the
+          matches.
+        - Heaps are cleaned lazily: an emptied or removed lot is dropped
+          from the calendar at once and skipped when it reaches a heap top.
+        - Lots cover part or all of a pantry row's quantity. Stock without
+          a lot has no expiry and is used after every dated lot.
+        - Mutations only change memory; callers persist() once per
+          operation (Pantry, PantryBatch).
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/csv.h"
+    #include "../../vendor/sys/dates.h"
+
+    PantryLots:
+        private:
+            - lots                      : Lot id -> live lot
+            - heaps                     : Pantry id -> (expiry, lot id) min-heap
+            - calendar                  : Every live (expiry, lot id), ordered
+            - totals                    : Pantry id -> quantity held in lots
+            - maxId / loaded / dirty    : Next id source / rows read / unsaved changes
+            - topOf(pantryId)           : Live heap top (drops stale entries)
+            - drop(lotId)               : Remove an emptied lot
+        public:
+            - shared()                  : Shared instance (static)
+            - load()                    : Read pantry_lots.csv once
+            - add(pantryId, q, expiry)  : New lot, returns its id
+            - consume(pantryId, amount) : FEFO deduction, returns amount taken from lots
+            - trimTo(pantryId, total)   : Keep lot total within the row quantity
+            - removeIngredient(pantryId): Drop every lot of an ingredient
+            - tracked(pantryId)         : Quantity held in lots
+            - nextExpiry(pantryId)      : Earliest expiry (Dates::NONE if none)
+            - lotsFor(pantryId)         : Lots of an ingredient in FEFO order
+            - expiringBetween(from, to) : Lots expiring in [from, to], soonest first
+            - persist()                 : Write pantry_lots.csv once (if changed)
+            - discard()                 : Drop unsaved changes (reload from disk next time)
+*/
+class PantryLots {
+private:
+    typedef pair<int, int> Key;                     // (expiry, lot id)
+    typedef priority_queue<Key, vector<Key>, greater<Key>> MinHeap;
+
+    unordered_map<int, PantryLot> lots;             // live lots by id
+    unordered_map<int, MinHeap> heaps;              // per ingredient FEFO order
+    set<Key> calendar;                              // global expiry calendar
+    unordered_map<int, double> totals;              // lot quantity per ingredient
+    int maxId = 0;                                  // largest lot id seen
+    bool loaded = false;                            // lots mirror pantry_lots.csv
+    bool dirty = false;                             // unsaved changes
+
+    PantryLots() {}
+
+    /*
+        Index a lot in its heap and the calendar
+    */
+    void index(const PantryLot& lot) {
+        lots[lot.id] = lot;
+        dirty = true;
+        heaps[lot.pantryId].push(Key(lot.expiry, lot.id));
+        calendar.insert(Key(lot.expiry, lot.id));
+        totals[lot.pantryId] += lot.quantity;
+        if (lot.id > maxId) { maxId = lot.id; }
+    }
+
+    /*
+        Live lot at the top of an ingredient's heap (nullptr if none)
+    */
+    PantryLot* topOf(int pantryId) {
+        auto heap = heaps.find(pantryId);
+        if (heap == heaps.end()) return nullptr;
+        while (!heap->second.empty()) {
+            auto hit = lots.find(heap->second.top().second);
+            if (hit != lots.end()) return &hit->second;     // live lot
+            heap->second.pop();                     // stale entry
+        }
+        heaps.erase(heap);                          // nothing left for this ingredient
+        return nullptr;
+    }
+
+    /*
+        Remove a lot (heap entry is dropped lazily)
+    */
+    void drop(int lotId) {
+        auto hit = lots.find(lotId);
+        if (hit == lots.end()) return;
+        calendar.erase(Key(hit->second.expiry, lotId));
+        totals[hit->second.pantryId] -= hit->second.quantity;
+        if (totals[hit->second.pantryId] < 1e-9) { totals.erase(hit->second.pantryId); }
+        lots.erase(hit);
+        dirty = true;
+    }
+
+public:
+    PantryLots(const PantryLots&) = delete;
+    PantryLots& operator=(const PantryLots&) = delete;
+
+    static PantryLots& shared() {
+        static PantryLots instance;                 // shared by every pantry call
+        return instance;
+    }
+
+    /*
+        Read pantry_lots.csv once per session
+    */
+    void load() {
+        if (loaded) return;                         // already in memory
+        lots.clear(); heaps.clear(); calendar.clear(); totals.clear(); maxId = 0;
+        CSV csv("pantry_lots.csv");
+        vector<vector<string>> data = csv.read();   // single read
+        for (int i = 0; i < data.size(); i++) {
+            PantryLot lot = PantryLot::fromCSVRow(data[i]);
+            if (lot.id > 0 && lot.quantity > 0.0 && lot.expiry != Dates::NONE) { index(lot); }
+        }
+        loaded = true;
+        dirty = false;                              // memory matches the file
+    }
+
+    /*
+        Add a lot, returns its id (0 when nothing to track)
+    */
+    int add(int pantryId, double quantity, int expiry) {
+        load();
+        if (pantryId <= 0 || quantity <= 0.0 || expiry == Dates::NONE) return 0;
+        PantryLot lot(maxId + 1, pantryId, quantity, expiry);
+        index(lot);
+        return lot.id;
+    }
+
+    /*
+        Deduct amount from an ingredient's lots, soonest expiry first
+            - returns how much came out of lots (rest is undated stock)
+    */
+    double consume(int pantryId, double amount) {
+        load();
+        double taken = 0.0;
+        while (amount - taken > 1e-9) {
+            PantryLot* lot = topOf(pantryId);       // O(1) peek, O(log n) per pop
+            if (lot == nullptr) break;              // no dated stock left
+            double use = min(lot->quantity, amount - taken);
+            lot->quantity -= use;
+            dirty = true;
+            totals[pantryId] -= use;
+            taken += use;
+            if (lot->quantity < 1e-9) { drop(lot->id); }    // lot used up
+        }
+        return taken;
+    }
+
+    /*
+        Keep an ingredient's lot total within its pantry quantity
+    */
+    void trimTo(int pantryId, double total) {
+        double excess = tracked(pantryId) - total;
+        if (excess > 1e-9) { consume(pantryId, excess); }
+    }
+
+    /*
+        Drop every lot of an ingredient
+    */
+    void removeIngredient(int pantryId) {
+        load();
+        while (PantryLot* lot = topOf(pantryId)) { drop(lot->id); }
+    }
+
+    double tracked(int pantryId) {
+        load();
+        auto hit = totals.find(pantryId);
+        return hit == totals.end() ? 0.0 : hit->second;
+    }
+
+    int nextExpiry(int pantryId) {
+        load();
+        PantryLot* lot = topOf(pantryId);
+        return lot == nullptr ? Dates::NONE : lot->expiry;
+    }
+
+    /*
+        Lots of an ingredient in FEFO order
+    */
+    vector<PantryLot> lotsFor(int pantryId) {
+        load();
+        vector<PantryLot> result;
+        auto heap = heaps.find(pantryId);
+        if (heap == heaps.end()) return result;
+        MinHeap copy = heap->second;                // leave the live heap untouched
+        while (!copy.empty()) {
+            auto hit = lots.find(copy.top().second);
+            if (hit != lots.end()) { result.push_back(hit->second); }
+            copy.pop();
+        }
+        return result;
+    }
+
+    /*
+        Lots expiring within [from, to], soonest first
+    */
+    vector<PantryLot> expiringBetween(int from, int to) {
+        load();
+        vector<PantryLot> result;
+        auto it = calendar.lower_bound(Key(from, 0));   // O(log n) seek
+        for (; it != calendar.end() && it->first <= to; ++it) {
+            result.push_back(lots[it->second]);
+        }
+        return result;
+    }
+
+    /*
+        Write pantry_lots.csv (calendar order) when something changed
+    */
+    bool persist() {
+        if (!loaded || !dirty) return true;         // nothing changed
+        vector<vector<string>> data;
+        data.reserve(lots.size());
+        for (const Key& key : calendar) {
+            data.push_back(lots[key.second].toCSVRow());
+        }
+        CSV csv("pantry_lots.csv");
+        if (csv.write(data)) { dirty = false; return true; }    // single write
+        loaded = false;                             // reload from disk next time
+        return false;
+    }
+
+    /*
+        Drop unsaved changes (the pantry write they belong to failed)
+    */
+    void discard() {
+        loaded = false;                             // reload from disk next time
+        dirty = false;
+    }
+};
+
+#endif                                              // PANTRYLOTS_H
@@ -4,6 +4,8 @@
 #include "viewpantry.cpp"
 #include "updatepantryitem.cpp"
 #include "deletepantryitem.cpp"
+#include "expiringpantry.cpp"
+#include "viewpantryhistory.cpp"
 
 using namespace std;
 
@@ -29,12 +31,16 @@ using namespace std;
     #include "viewpantry.cpp"           // ViewPantryPage (page)
     #include "updatepantryitem.cpp"     // UpdatePantryItemModal (modal)
     #include "deletepantryitem.cpp"     // DeletePantryItemModal (modal)
+    #include "expiringpantry.cpp"       // ExpiringPantryModal (modal)
+    #include "viewpantryhistory.cpp"    // ViewPantryHistoryModal (modal)
 
     Options:
         - "Add Ingredient"     : Opens AddPantryItemModal (collect → confirm → save → return)
         - "View Pantry"        : Opens ViewPantryPage (displays all pantry items)
         - "Update Quantity"    : Opens UpdatePantryItemModal (prompt for id → update → return)
         - "Delete Ingredient"  : Opens DeletePantryItemModal (prompt for id → confirm → delete → return)
+        - "Expiring Soon"      : Opens ExpiringPantryModal (prompt for days → list lots → return)
+        - "Pantry History"     : Opens ViewPantryHistoryModal (prompt for date → levels and changes → return)
 */
 class PantryManagerPage : public Page {
 public:
@@ -50,23 +56,27 @@ public:
 
         this->options = {
             Options("Add Ingredient", []() {        // option 1: add ingredient
-                AddPantryItemModal addModal;        // create modal instance
-                addModal.init();                    // open modal
+                Navigator::shared().open(new AddPantryItemModal()); // open modal
             }),
 
             Options("View Pantry", []() {           // option 2: view pantry
-                ViewPantryPage viewPage;            // create page instance
-                viewPage.init();                    // open page
+                Navigator::shared().open(new ViewPantryPage()); // open page
             }),
 
             Options("Update Quantity", []() {       // option 3: update quantity
-                UpdatePantryItemModal updateModal;  // create modal instance
-                updateModal.init();                 // open modal
+                Navigator::shared().open(new UpdatePantryItemModal()); // open modal
             }),
 
             Options("Delete Ingredient", []() {     // option 4: delete ingredient
-                DeletePantryItemModal deleteModal;  // create modal instance
-                deleteModal.init();                 // open modal
+                Navigator::shared().open(new DeletePantryItemModal()); // open modal
+            }),
+
+            Options("Expiring Soon", []() {         // option 5: expiring lots
+                Navigator::shared().open(new ExpiringPantryModal()); // open modal
+            }),
+
+            Options("Pantry History", []() {        // option 6: pantry as of a date
+                Navigator::shared().open(new ViewPantryHistoryModal()); // open modal
             })
         };
     }
@@ -78,4 +88,11 @@ public:
               the header and the options list.
     */
     void schema() override {}                       // empty schema (menu only)
+
+    /*
+        Menu only - the frame never changes, so it is drawn once
+    */
+    unsigned long long dataVersion() override {
+        return 1;
+    }
 };
@@ -0,0 +1,278 @@
+#ifndef PANTRYRESERVATIONS_H                    // for no dup def
+#define PANTRYRESERVATIONS_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/units.h"
+#include "pantry.cpp"
+#include "pantrybatch.cpp"
+#include <vector>
+#include <string>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <unordered_map>
+
+using namespace std;
+
+/*
+    PantryReservations Struct
+
+    Lets many threads (e.g. several kit-assembly lines) draw from the same
+    pantry stock without double-allocating it and without a global lock.
+
+    How it works:
+        - open() snapshots the pantry into one Slot per row. Each slot holds
+          atomic counters in fixed point (SCALE units per 1 of the row's
+          unit): available, reserved, committed (taken, not yet written)
+          and stored (the quantity pantry.csv holds).
+        - reserve() moves an amount from available to reserved with a
+          compare-and-swap loop, failing instead of going below zero, so two
+          threads can never both get the last unit. It returns a Hold.
+        - commit(hold) turns a reservation into a draw (reserved ->
+          committed); release(hold) gives it back (reserved -> available).
+          Both touch one slot only. Slots are cache-line aligned so threads
+          working on different ingredients do not contend.
+        - flush() writes every committed amount to the pantry with one
+          PantryBatch commit (one pantry.csv write for the whole batch).
+          The draws are kept for the next flush only when pantry.csv was
+          not written; if only pantry_lots.csv failed the stock is already
+          drawn, so lotsSaved reports it and nothing is retried.
+          Like every Pantry call it must run on the thread that owns the
+          pantry store (the UI thread), while workers only touch counters.
+        - Pantry::listeners() keeps available in step with edits made
+          elsewhere (a restock adds, a delete removes the row's stock).
+          Rows created after open() are picked up by the next open() once
+          nothing is reserved or committed.
+        - The slot table is built once and never resized, so slotOf() and
+          the counters are read without locking.
+        - bench/reservations.cpp is a stand-alone stress driver: N threads
+          reserve, release and drain shared slots and it fails if any unit
+          is handed out twice or lost.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/units.h"
+    #include "pantry.cpp"
+    #include "pantrybatch.cpp"
+
+    PantryReservations:
+        public:
+            - Hold                      : One reservation (slot and amount)
+            - SCALE                     : Counter units per quantity unit
+            - lotsSaved                 : pantry_lots.csv written by the last flush
+            - open()                    : Snapshot the pantry if needed (owner thread)
+            - size()                    : Number of slots
+            - slotOf(name)              : Slot of an ingredient (-1 if missing)
+            - nameOf(slot) / unitOf(slot) : Row name and unit of a slot
+            - available(slot) / reserved(slot) : Current counters
+            - reserve(slot, amount)     : Reserve an amount in the row's unit
+            - reserve(name, amount, unit) : Reserve with unit conversion
+            - commit(hold)              : Draw a reserved amount
+            - release(hold)             : Return a reserved amount
+            - flush()                   : Write committed draws in one batch (owner thread)
+            - shared()                  : Process-wide engine (static)
+        private:
+            - Slot                      : Atomic counters of one pantry row
+            - load()                    : Build slots from the pantry store
+            - idle()                    : Nothing reserved or committed
+            - onStock(row, removed)     : Follow a pantry change made elsewhere
+            - toUnits(q) / fromUnits(u) : Fixed-point conversion (static)
+*/
+struct PantryReservations {
+public:
+    struct Hold {
+        int slot = -1;                              // -1: nothing held
+        long long units = 0;                        // fixed-point amount
+
+        bool ok() const { return slot >= 0; }
+    };
+
+    static constexpr long long SCALE = 1000000;     // counter units per 1 quantity unit
+
+    bool lotsSaved = true;                          // pantry_lots.csv written by last flush
+
+    /*
+        Snapshot the pantry (first use, or stale and idle)
+    */
+    void open() {
+        if (!built || (stale && idle())) load();
+    }
+
+    size_t size() { return count; }
+
+    /*
+        Slot of an ingredient (case-insensitive, -1 if not in the pantry)
+    */
+    int slotOf(string name) {
+        auto hit = byName.find(out.toLowerCase(name));
+        return hit == byName.end() ? -1 : hit->second;
+    }
+
+    string nameOf(int slot) { return rows[slot].name; }
+    string unitOf(int slot) { return rows[slot].unit; }
+    double available(int slot) { return fromUnits(slots[slot].available.load()); }
+    double reserved(int slot) { return fromUnits(slots[slot].reserved.load()); }
+
+    /*
+        Reserve an amount in the row's own unit (empty Hold if short)
+    */
+    Hold reserve(int slot, double amount) {
+        Hold hold;
+        if (slot < 0 || size_t(slot) >= count || amount < 0.0) return hold;
+        long long want = toUnits(amount);
+        Slot& s = slots[slot];
+        long long have = s.available.load(memory_order_relaxed);
+        do {
+            if (have < want) return hold;           // would over-allocate
+        } while (!s.available.compare_exchange_weak(have, have - want, memory_order_acq_rel, memory_order_relaxed));
+        s.reserved.fetch_add(want, memory_order_relaxed);
+        hold.slot = slot;
+        hold.units = want;
+        return hold;
+    }
+
+    /*
+        Reserve an amount given in any unit convertible to the row's unit
+    */
+    Hold reserve(string name, double amount, string unit) {
+        int slot = slotOf(name);
+        if (slot < 0) return Hold();
+        double converted = amount;
+        if (!Units::convert(amount, unit, rows[slot].unit, name, converted)) return Hold();     // not comparable
+        return reserve(slot, converted);
+    }
+
+    /*
+        Draw a reserved amount (written by the next flush)
+    */
+    bool commit(Hold& hold) {
+        if (!hold.ok()) return false;
+        Slot& s = slots[hold.slot];
+        s.reserved.fetch_sub(hold.units, memory_order_relaxed);
+        s.committed.fetch_add(hold.units, memory_order_release);
+        hold = Hold();                              // used up
+        return true;
+    }
+
+    /*
+        Give a reserved amount back
+    */
+    bool release(Hold& hold) {
+        if (!hold.ok()) return false;
+        Slot& s = slots[hold.slot];
+        s.reserved.fetch_sub(hold.units, memory_order_relaxed);
+        s.available.fetch_add(hold.units, memory_order_acq_rel);
+        hold = Hold();                              // used up
+        return true;
+    }
+
+    /*
+        Write every committed draw to the pantry with one batch
+            - returns false when pantry.csv was not written (draws are kept for retry)
+    */
+    bool flush() {
+        lotsSaved = true;
+        PantryBatch batch;
+        vector<pair<int, long long>> taken;         // (slot, units) in this batch
+        for (size_t i = 0; i < count; i++) {
+            long long units = slots[i].committed.exchange(0, memory_order_acquire);
+            if (units == 0) continue;
+            slots[i].stored.fetch_sub(units);       // so our own pantry event is a no-op
+            taken.push_back({ int(i), units });
+            batch.subtract(rows[i].name, fromUnits(units), rows[i].unit);
+        }
+        if (taken.empty()) return true;             // nothing to write
+        if (batch.commit()) {                       // single pantry.csv write
+            lotsSaved = batch.lotsSaved;            // stock drawn even if lots failed
+            return true;
+        }
+
+        for (size_t i = 0; i < taken.size(); i++) { // keep the draws for the next try
+            slots[taken[i].first].stored.fetch_add(taken[i].second);
+            slots[taken[i].first].committed.fetch_add(taken[i].second);
+        }
+        return false;
+    }
+
+    /*
+        Process-wide engine (subscribes on first use)
+    */
+    static PantryReservations& shared() {
+        static PantryReservations engine;
+        return engine;
+    }
+
+private:
+    struct alignas(64) Slot {                       // one cache line per row
+        atomic<long long> available{0};             // free to reserve
+        atomic<long long> reserved{0};              // held, not yet drawn
+        atomic<long long> committed{0};             // drawn, not yet written
+        atomic<long long> stored{0};                // quantity in pantry.csv
+    };
+
+    unique_ptr<Slot[]> slots;                       // fixed after load()
+    size_t count = 0;
+    vector<Pantry> rows;                            // slot -> pantry row (name, unit)
+    unordered_map<string, int> byName;              // folded name -> slot
+    unordered_map<int, int> byId;                   // pantry id -> slot
+    bool built = false;
+    atomic<bool> stale{false};                      // pantry gained rows since load()
+
+    PantryReservations() {
+        Pantry::listeners().push_back([this](const Pantry& row, bool removed) {
+            if (built) onStock(row, removed);
+        });
+    }
+
+    /*
+        Build one slot per pantry row
+    */
+    void load() {
+        rows = Pantry::loadAll();                   // cached store
+        count = rows.size();
+        slots.reset(new Slot[count > 0 ? count : 1]);
+        byName.clear();
+        byId.clear();
+        for (size_t i = 0; i < count; i++) {
+            long long units = toUnits(rows[i].quantity);
+            slots[i].available.store(units);
+            slots[i].stored.store(units);
+            byName.emplace(out.toLowerCase(rows[i].name), int(i));  // first row wins, as in Pantry
+            byId[rows[i].id] = int(i);
+        }
+        built = true;
+        stale = false;
+    }
+
+    bool idle() {
+        for (size_t i = 0; i < count; i++) {
+            if (slots[i].reserved.load() != 0 || slots[i].committed.load() != 0) return false;
+        }
+        return true;
+    }
+
+    /*
+        Apply a pantry change made outside the engine to available
+    */
+    void onStock(const Pantry& row, bool removed) {
+        auto hit = byId.find(row.id);
+        if (hit == byId.end()) {                    // new row: needs a new slot
+            if (!removed) stale = true;
+            return;
+        }
+        Slot& s = slots[hit->second];
+        long long now = removed ? 0 : toUnits(row.quantity);
+        long long before = s.stored.exchange(now);
+        s.available.fetch_add(now - before);        // may go negative until restocked
+    }
+
+    static long long toUnits(double quantity) {
+        return quantity > 0.0 ? llround(quantity * double(SCALE)) : 0;
+    }
+
+    static double fromUnits(long long units) {
+        return double(units) / double(SCALE);
+    }
+};
+
+#endif                                              // PANTRYRESERVATIONS_H
@@ -50,7 +50,7 @@ protected:
         
         for (int i = 0; i < items.size(); i++) {
             Pantry item = items[i];                 // get current item
-            string line = to_string(i + 1) + ". " + item.name + " - " + item.quantity + " " + item.unit + " (ID: " + to_string(item.id) + ")";    // format item line
+            string line = to_string(i + 1) + ". " + item.name + " - " + out.formatNumber(item.quantity) + " " + item.unit + " (ID: " + to_string(item.id) + ")";    // format item line
             out.coutln(line);                       // display item
         }
         
@@ -70,7 +70,7 @@ protected:
         out.coutln("Current details:");             // display current details
         item.displayPreview();                      // show ingredient details
         
-        string newQuantity = out.inputs("Enter new quantity: ");   // prompt for new quantity
+        double newQuantity = out.inputd("Enter new quantity: ");   // prompt for new quantity
         
         if (item.updateQuantity(newQuantity)) {     // update quantity
             out.br();
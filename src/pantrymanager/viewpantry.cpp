@@ -1,6 +1,8 @@
 #include "../../vendor/sys/out.h"
 #include "../../vendor/base/page.h"
+#include "../../vendor/sys/dates.h"
 #include "pantry.cpp"
+#include "pantrylots.cpp"
 
 using namespace std;
 
@@ -13,13 +15,16 @@ using namespace std;
     How it works:
         - Loads all pantry items from pantry.csv
         - Displays each item with its id, name, quantity, and unit
+        - Items with dated lots also show the next expiry (heap top, O(1))
         - If pantry is empty, shows a message
         - Provides a back option to return to pantry manager
 
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/base/page.h"
+    #include "../../vendor/sys/dates.h"
     #include "pantry.cpp"
+    #include "pantrylots.cpp"
 
     ViewPantryPage:
         protected:
@@ -44,12 +49,17 @@ protected:
             return;                                 // exit schema
         }
         
+        PantryLots& lots = PantryLots::shared();    // expiry lots
         out.coutln("Pantry Inventory (" + to_string(items.size()) + " item(s)):");  // display count
         out.br();
         
         for (int i = 0; i < items.size(); i++) {
             Pantry item = items[i];                 // get current item
-            string line = to_string(i + 1) + ". " + item.name + " - " + item.quantity + " " + item.unit + " (ID: " + to_string(item.id) + ")";    // format item line
+            string line = to_string(i + 1) + ". " + item.name + " - " + out.formatNumber(item.quantity) + " " + item.unit + " (ID: " + to_string(item.id) + ")";    // format item line
+            int next = lots.nextExpiry(item.id);    // soonest lot
+            if (next != Dates::NONE) {
+                line += " - next expiry " + Dates::format(next) + " (" + out.formatNumber(lots.tracked(item.id)) + " " + item.unit + " dated)";
+            }
             out.coutln(line);                       // display item
         }
         
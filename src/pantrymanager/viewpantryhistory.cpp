@@ -0,0 +1,95 @@
+#include "../../vendor/sys/out.h"
+#include "../../vendor/base/modal.h"
+#include "../../vendor/sys/dates.h"
+#include "pantryhistory.cpp"
+
+using namespace std;
+
+/*
+    ViewPantryHistoryModal Class
+
+    This modal shows what the pantry held at the end of a given day and the
+    changes recorded on that day (audit trail).
+
+    How it works:
+        - Prompts for a date (YYYY-MM-DD, blank for today)
+        - Asks PantryHistory for the levels as of that day (latest snapshot
+          taken by then plus its short log tail; no full replay)
+        - Lists the levels, then every event recorded on that day
+        - Automatically returns to parent page after completion
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/base/modal.h"
+    #include "../../vendor/sys/dates.h"
+    #include "pantryhistory.cpp"
+
+    ViewPantryHistoryModal:
+        private:
+            - promptDay()               : Prompts for a date (blank = today)
+        protected:
+            - schema()                  : Main modal logic (override from Modal)
+        public:
+            - ViewPantryHistoryModal()  : Constructor
+*/
+class ViewPantryHistoryModal : public Modal {
+private:
+    /*
+        Prompt for a date (blank for today)
+    */
+    int promptDay() {
+        while (true) {
+            string text = out.trim(out.inputs("Show pantry as of (YYYY-MM-DD, blank for today): "));
+            int day = Dates::today();
+            if (text == "" || Dates::parse(text, day)) { return day; }  // valid input
+            out.coutln("Invalid date. Use YYYY-MM-DD.");
+        }
+    }
+
+protected:
+    /*
+        Main modal schema - Pantry levels and changes for a day
+    */
+    void schema() override {
+        out.hr();                                   // horizontal rule
+        out.br();
+
+        int day = promptDay();
+        PantryHistory& history = PantryHistory::shared();
+        map<int, PantryHistory::Level> levels;
+        out.br();
+        if (!history.levelsAt(day, levels)) {       // before history began
+            out.coutln("No pantry history recorded by " + Dates::format(day) + ".");
+            out.br();
+            return;                                 // exit modal
+        }
+
+        out.coutln("Pantry as of " + Dates::format(day) + " (" + to_string(levels.size()) + " item(s)):");
+        out.br();
+        int n = 1;
+        for (auto& entry : levels) {
+            out.coutln(to_string(n++) + ". " + entry.second.name + " - " + out.formatNumber(entry.second.quantity) + " " + entry.second.unit + " (ID: " + to_string(entry.first) + ")");
+        }
+        out.br();
+
+        vector<PantryEvent> events = history.eventsOn(day);     // audit trail
+        if (events.size() == 0) {
+            out.coutln("No changes recorded on " + Dates::format(day) + ".");
+            out.br();
+            return;
+        }
+        out.coutln("Changes on " + Dates::format(day) + ":");
+        for (int i = 0; i < events.size(); i++) {
+            PantryEvent e = events[i];
+            string sign = e.delta > 0 ? "+" : "";
+            out.coutln("- #" + to_string(e.seq) + " " + e.type + " " + e.name + " " + sign + out.formatNumber(e.delta) + " " + e.unit + " -> " + out.formatNumber(e.level) + " " + e.unit);
+        }
+        out.br();
+    }
+
+public:
+    /*
+        Constructor
+    */
+    ViewPantryHistoryModal() : Modal() {}           // default constructor
+};
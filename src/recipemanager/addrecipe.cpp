@@ -10,7 +10,8 @@
     It collects recipe data, displays a preview, and allows editing before saving.
 
     How it works:
-        - Collects recipe name, ingredients, and instructions from user
+        - Collects recipe name, ingredients, instructions and (optionally)
+          the number of servings the amounts make
         - Displays a preview of the recipe
         - Asks for confirmation (y/n)
         - If not confirmed, allows editing specific fields
@@ -26,6 +27,7 @@
         private:
             - recipe                    : Recipe object being created
             - collectRecipeData()       : Prompts user for recipe information
+            - inputServings(prompt)     : Reads base servings (0 when blank)
             - confirmRecipe()           : Shows preview and asks for confirmation
             - changeRecipe()            : Allows editing specific recipe fields
         protected:
@@ -47,9 +49,19 @@ private:
         string ingredientsInput = out.inputs("Enter ingredients (comma-separated; use name:amount:unit optional): ");  // get ingredients input with measurement format
         recipe.ingredients = Recipe::parseIngredients(ingredientsInput);    // parse ingredients to vector
         recipe.instructions = out.inputs("Enter instructions: ");           // get cooking instructions
+        recipe.servings = inputServings("Enter servings (blank if unknown): ");    // get base servings
         out.br();
     }
 
+    /*
+        Read base servings (blank or invalid = 0, unknown)
+    */
+    int inputServings(string prompt) {
+        double value = 0.0;
+        if (!out.parseNumber(out.inputs(prompt), value) || value < 1.0) return 0;
+        return int(value);                                                  // whole servings
+    }
+
     /*
         Display recipe preview and ask for confirmation
     */
@@ -68,7 +80,8 @@ private:
         out.coutln("1. Recipe name");                                       // option 1
         out.coutln("2. Ingredients");                                       // option 2
         out.coutln("3. Instructions");                                      // option 3
-        out.coutln("4. None");                                              // option 4
+        out.coutln("4. Servings");                                          // option 4
+        out.coutln("5. None");                                              // option 5
         int choice = out.inputi("Enter your choice: ");                     // get user choice
         out.br();                                                           // blank line
 
@@ -90,7 +103,12 @@ private:
                 out.coutln("Instructions changed successfully!");           // success message
                 out.br();                                                   // blank line
                 break;
-            case 4:                                                         // no changes
+            case 4:                                                         // change servings
+                recipe.servings = inputServings("Servings (blank if unknown): ");  // get new servings
+                out.coutln("Servings changed successfully!");               // success message
+                out.br();                                                   // blank line
+                break;
+            case 5:                                                         // no changes
                 return;                                                     // exit function
             default:                                                        // invalid choice
                 out.coutln("Invalid choice!");                              // error message
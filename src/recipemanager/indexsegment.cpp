@@ -0,0 +1,385 @@
+#ifndef INDEXSEGMENT_H
+#define INDEXSEGMENT_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/bitmap.h"
+#include "../../vendor/sys/mappedfile.h"
+#include "recipe.cpp"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <map>
+#include <set>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+/*
+    SegmentData Struct
+
+    Mutable, in-memory form of one search index segment. It is filled from
+    recipes (or from existing segments during a merge) and serialized into
+    the binary segment format read by IndexSegment.
+
+    Binary layout (all integers are uint32, native byte order):
+        header   : magic, format, docs, tombstones, name terms, ingredient
+                   terms, posting words, string bytes
+        docs     : { id, name offset, name length } sorted by id
+        tombs    : ids deleted from older segments, sorted
+        name dict: { term offset, term length, posting offset, posting length }
+                   sorted by term
+        ing dict : same layout as name dict
+        postings : ascending recipe ids per term
+        strings  : recipe names and terms (offsets are relative to here)
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/bitmap.h"
+    #include "../../vendor/sys/mappedfile.h"
+    #include "recipe.cpp"
+
+    SegmentData:
+        public:
+            - docs                      : Recipe id -> recipe name
+            - nameTerms                 : Name word -> ascending ids
+            - ingredientTerms           : Ingredient name -> ascending ids
+            - tombstones                : Ids removed from older segments
+            - tokenize(text)            : Lowercase word split (static)
+            - add(recipe)               : Index one recipe (replaces same id)
+            - remove(id)                : Drop a recipe and record a tombstone
+            - serialize()               : Encode to the binary segment format
+*/
+struct SegmentData {
+public:
+    static constexpr uint32_t MAGIC = 0x58495043;                           // "CPIX"
+    static constexpr uint32_t FORMAT = 1;                                   // layout version
+    static constexpr int HEADER_WORDS = 8;                                  // header size in uint32
+
+    map<uint32_t, string> docs;                                             // id -> name
+    map<string, vector<uint32_t>> nameTerms;                                // word -> ids
+    map<string, vector<uint32_t>> ingredientTerms;                          // ingredient -> ids
+    set<uint32_t> tombstones;                                               // deleted ids
+
+    /*
+        Split text into lowercase alphanumeric words
+    */
+    static vector<string> tokenize(string text) {
+        vector<string> words;
+        string current = "";
+        for (int i = 0; i < text.length(); i++) {
+            char c = text[i];
+            if (isalnum(static_cast<unsigned char>(c))) {
+                current += char(tolower(static_cast<unsigned char>(c)));    // accumulate word
+            } else if (!current.empty()) {
+                words.push_back(current);                                   // word boundary
+                current = "";
+            }
+        }
+        if (!current.empty()) words.push_back(current);                     // trailing word
+        return words;
+    }
+
+    /*
+        Insert id into an ascending posting list
+    */
+    static void addPosting(vector<uint32_t>& list, uint32_t id) {
+        if (list.empty() || list.back() < id) { list.push_back(id); return; }   // ascending fast path
+        auto it = lower_bound(list.begin(), list.end(), id);
+        if (it == list.end() || *it != id) list.insert(it, id);
+    }
+
+    /*
+        Index one recipe
+    */
+    void add(const Recipe& recipe) {
+        if (recipe.id <= 0) return;                                         // skip rows without id
+        uint32_t rid = uint32_t(recipe.id);
+        if (docs.count(rid)) remove(rid);                                   // replace previous version
+        docs[rid] = recipe.name;
+
+        vector<string> words = tokenize(recipe.name);                       // index name words
+        for (int w = 0; w < words.size(); w++) {
+            addPosting(nameTerms[words[w]], rid);
+        }
+        for (int j = 0; j < recipe.ingredients.size(); j++) {               // index ingredient names
+            string iname = ""; string iamount = ""; string iunit = "";
+            Recipe::splitIngredient(recipe.ingredients[j], iname, iamount, iunit);
+            string key = out.toLowerCase(iname);
+            if (!key.empty()) addPosting(ingredientTerms[key], rid);
+        }
+    }
+
+    /*
+        Drop a recipe from this segment and hide it in older ones
+    */
+    void remove(uint32_t id) {
+        docs.erase(id);
+        tombstones.insert(id);
+        map<string, vector<uint32_t>>* dicts[2] = { &nameTerms, &ingredientTerms };
+        for (int d = 0; d < 2; d++) {
+            for (auto it = dicts[d]->begin(); it != dicts[d]->end();) {     // strip id from postings
+                vector<uint32_t>& list = it->second;
+                auto pos = lower_bound(list.begin(), list.end(), id);
+                if (pos != list.end() && *pos == id) list.erase(pos);
+                if (list.empty()) it = dicts[d]->erase(it); else ++it;
+            }
+        }
+    }
+
+    /*
+        Encode to the binary segment format
+    */
+    string serialize() const {
+        vector<uint32_t> words(HEADER_WORDS, 0);
+        vector<uint32_t> postings;
+        string strings = "";
+
+        words[0] = MAGIC;
+        words[1] = FORMAT;
+        words[2] = uint32_t(docs.size());
+        words[3] = uint32_t(tombstones.size());
+        words[4] = uint32_t(nameTerms.size());
+        words[5] = uint32_t(ingredientTerms.size());
+
+        for (auto it = docs.begin(); it != docs.end(); ++it) {              // docs section
+            words.push_back(it->first);
+            words.push_back(uint32_t(strings.size()));
+            words.push_back(uint32_t(it->second.size()));
+            strings += it->second;
+        }
+        for (uint32_t id : tombstones) words.push_back(id);                 // tombstones section
+
+        const map<string, vector<uint32_t>>* dicts[2] = { &nameTerms, &ingredientTerms };
+        for (int d = 0; d < 2; d++) {                                       // dictionary sections
+            for (auto it = dicts[d]->begin(); it != dicts[d]->end(); ++it) {
+                words.push_back(uint32_t(strings.size()));
+                words.push_back(uint32_t(it->first.size()));
+                words.push_back(uint32_t(postings.size()));
+                words.push_back(uint32_t(it->second.size()));
+                strings += it->first;
+                postings.insert(postings.end(), it->second.begin(), it->second.end());
+            }
+        }
+        words[6] = uint32_t(postings.size());
+        words[7] = uint32_t(strings.size());
+        words.insert(words.end(), postings.begin(), postings.end());
+
+        string bytes(words.size() * sizeof(uint32_t), '\0');
+        memcpy(&bytes[0], words.data(), bytes.size());
+        return bytes + strings;
+    }
+};
+
+/*
+    IndexSegment Struct
+
+    Read-only view of one serialized segment. Segments on disk are opened
+    with MappedFile and queried in place: nothing is decoded up front, terms
+    and postings are read straight from the mapped bytes.
+
+    How it works:
+        - openFile() maps a segment file; openBuffer() wraps bytes that were
+          just serialized (in-memory index without a file).
+        - match() scans the term dictionary for terms containing a needle and
+          ORs their postings (substring semantics of the old linear search).
+        - nameOf() binary-searches the docs section.
+        - loadInto() copies live docs and postings back into a SegmentData
+          (used to rewrite the delta segment and by merges).
+
+    IndexSegment:
+        private:
+            - file / buffer             : Backing storage
+            - base / length             : Segment bytes
+            - word(i)                   : Read uint32 at word index i
+            - text(offset, length)      : View into the strings section
+            - fits(offset, count, limit) : Range check for one entry (static)
+            - validate()                : Check the header, sections and entries
+        public:
+            - Field                     : FIELD_NAME or FIELD_INGREDIENT
+            - path                      : File name ("" for in-memory segments)
+            - openFile(path)            : Map and validate a segment file
+            - openBuffer(bytes)         : Use serialized bytes held in memory
+            - docCount()                : Number of documents
+            - ids()                     : Bitmap of document ids
+            - tombstones()              : Bitmap of ids hidden in older segments
+            - match(field, needle)      : Ids with a term containing needle
+            - nameOf(id, name)          : Recipe name lookup (false if absent)
+            - loadInto(data, keep)      : Copy docs in keep into a SegmentData
+*/
+struct IndexSegment {
+public:
+    enum Field { FIELD_NAME, FIELD_INGREDIENT };
+
+    string path;                                                            // "" when in memory
+
+private:
+    shared_ptr<MappedFile> file;                                            // mapped file (disk segments)
+    string buffer;                                                          // owned bytes (memory segments)
+    const char* base = nullptr;                                             // segment bytes
+    size_t length = 0;
+    uint32_t docs = 0, tombs = 0, nameCount = 0, ingCount = 0, postingWords = 0, stringBytes = 0;
+    size_t docsAt = 0, tombsAt = 0, nameAt = 0, ingAt = 0, postingsAt = 0, stringsAt = 0;   // word/byte offsets
+
+    uint32_t word(size_t index) const {
+        uint32_t value;
+        memcpy(&value, base + index * sizeof(uint32_t), sizeof(uint32_t));  // alignment-safe read
+        return value;
+    }
+
+    string_view text(uint32_t offset, uint32_t count) const {
+        return string_view(base + stringsAt + offset, count);
+    }
+
+    /*
+        True if [offset, offset + count) lies inside a section of `limit` items
+    */
+    static bool fits(uint32_t offset, uint32_t count, uint32_t limit) {
+        return uint64_t(offset) + count <= limit;
+    }
+
+    /*
+        Read the header and check that every section and every entry fits
+            - sections must add up to the file length
+            - every doc name and dictionary term must lie inside the strings
+              section, and every posting list inside the postings section,
+              so match(), nameOf() and loadInto() never read past the segment
+    */
+    bool validate() {
+        if (base == nullptr || length < SegmentData::HEADER_WORDS * sizeof(uint32_t)) return false;
+        if (word(0) != SegmentData::MAGIC || word(1) != SegmentData::FORMAT) return false;
+        docs = word(2); tombs = word(3); nameCount = word(4); ingCount = word(5);
+        postingWords = word(6); stringBytes = word(7);
+        docsAt = SegmentData::HEADER_WORDS;
+        tombsAt = docsAt + size_t(docs) * 3;
+        nameAt = tombsAt + tombs;
+        ingAt = nameAt + size_t(nameCount) * 4;
+        postingsAt = ingAt + size_t(ingCount) * 4;
+        stringsAt = (postingsAt + postingWords) * sizeof(uint32_t);
+        if (stringsAt + stringBytes != length) return false;                // truncated or corrupt
+        for (uint32_t i = 0; i < docs; i++) {
+            size_t entry = docsAt + size_t(i) * 3;
+            if (!fits(word(entry + 1), word(entry + 2), stringBytes)) return false;
+        }
+        size_t ats[2] = { nameAt, ingAt };
+        uint32_t counts[2] = { nameCount, ingCount };
+        for (int d = 0; d < 2; d++) {
+            for (uint32_t t = 0; t < counts[d]; t++) {
+                size_t entry = ats[d] + size_t(t) * 4;
+                if (!fits(word(entry), word(entry + 1), stringBytes)) return false;
+                if (!fits(word(entry + 2), word(entry + 3), postingWords)) return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    IndexSegment() {}
+    IndexSegment(const IndexSegment&) = delete;                             // base points into owned storage
+    IndexSegment& operator=(const IndexSegment&) = delete;
+
+    /*
+        Map and validate a segment file
+    */
+    bool openFile(string filePath) {
+        file = make_shared<MappedFile>();
+        if (!file->open(filePath)) { file.reset(); return false; }
+        path = filePath;
+        base = file->data();
+        length = file->size();
+        return validate();
+    }
+
+    /*
+        Use serialized bytes kept in memory
+    */
+    bool openBuffer(string bytes) {
+        buffer = bytes;
+        path = "";
+        base = buffer.data();
+        length = buffer.size();
+        return validate();
+    }
+
+    size_t docCount() const { return docs; }
+
+    Bitmap ids() const {
+        Bitmap result;
+        for (uint32_t i = 0; i < docs; i++) result.add(word(docsAt + i * 3));   // docs are sorted
+        return result;
+    }
+
+    Bitmap tombstones() const {
+        Bitmap result;
+        for (uint32_t i = 0; i < tombs; i++) result.add(word(tombsAt + i));
+        return result;
+    }
+
+    /*
+        Ids having a term that contains the needle
+    */
+    Bitmap match(Field field, string needle) const {
+        size_t at = field == FIELD_NAME ? nameAt : ingAt;
+        uint32_t count = field == FIELD_NAME ? nameCount : ingCount;
+        Bitmap result;
+        for (uint32_t t = 0; t < count; t++) {                              // scan vocabulary in place
+            size_t entry = at + size_t(t) * 4;
+            if (text(word(entry), word(entry + 1)).find(needle) == string_view::npos) continue;
+            Bitmap postings;
+            uint32_t from = word(entry + 2); uint32_t n = word(entry + 3);
+            for (uint32_t p = 0; p < n; p++) postings.add(word(postingsAt + from + p));
+            result = result.orWith(postings);
+        }
+        return result;
+    }
+
+    /*
+        Recipe name for an id in this segment
+    */
+    bool nameOf(uint32_t id, string& name) const {
+        uint32_t lo = 0; uint32_t hi = docs;
+        while (lo < hi) {                                                   // binary search sorted docs
+            uint32_t mid = (lo + hi) / 2;
+            uint32_t value = word(docsAt + size_t(mid) * 3);
+            if (value == id) {
+                name = string(text(word(docsAt + size_t(mid) * 3 + 1), word(docsAt + size_t(mid) * 3 + 2)));
+                return true;
+            }
+            if (value < id) lo = mid + 1; else hi = mid;
+        }
+        return false;
+    }
+
+    /*
+        Copy docs contained in keep (and optionally tombstones) into data
+    */
+    void loadInto(SegmentData& data, const Bitmap& keep, bool withTombstones) const {
+        for (uint32_t i = 0; i < docs; i++) {
+            uint32_t id = word(docsAt + size_t(i) * 3);
+            if (keep.contains(id)) data.docs[id] = string(text(word(docsAt + size_t(i) * 3 + 1), word(docsAt + size_t(i) * 3 + 2)));
+        }
+        if (withTombstones) {
+            for (uint32_t i = 0; i < tombs; i++) data.tombstones.insert(word(tombsAt + i));
+        }
+        size_t ats[2] = { nameAt, ingAt };
+        uint32_t counts[2] = { nameCount, ingCount };
+        map<string, vector<uint32_t>>* dicts[2] = { &data.nameTerms, &data.ingredientTerms };
+        for (int d = 0; d < 2; d++) {
+            for (uint32_t t = 0; t < counts[d]; t++) {
+                size_t entry = ats[d] + size_t(t) * 4;
+                uint32_t from = word(entry + 2); uint32_t n = word(entry + 3);
+                vector<uint32_t>* list = nullptr;
+                for (uint32_t p = 0; p < n; p++) {
+                    uint32_t id = word(postingsAt + from + p);
+                    if (!keep.contains(id)) continue;                       // shadowed or deleted
+                    if (list == nullptr) list = &(*dicts[d])[string(text(word(entry), word(entry + 1)))];
+                    SegmentData::addPosting(*list, id);
+                }
+            }
+        }
+    }
+};
+
+#endif // INDEXSEGMENT_H
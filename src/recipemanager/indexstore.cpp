@@ -0,0 +1,365 @@
+#ifndef INDEXSTORE_H
+#define INDEXSTORE_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/threadpool.h"
+#include "recipe.cpp"
+#include "indexsegment.cpp"
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <system_error>
+
+using namespace std;
+
+/*
+    RecipeIndexStore Class
+
+    Persists the recipe search index as segment files under ./data/index/ so
+    the app can open it by memory-mapping instead of rebuilding it from
+    recipes.csv on every start.
+
+    Files:
+        manifest.txt     : which segments make up the index, plus a
+                           fingerprint (size and write time) of recipes.csv
+        seg_NNNNNN.idx   : immutable sealed segments
+        delta_NNNNNN.idx : small segment with the most recent changes
+
+    How it works:
+        - open() reads the manifest and maps every listed segment. It only
+          succeeds when the recipes.csv fingerprint still matches, so edits
+          made outside the app force a rebuild.
+        - rebuild() writes the whole catalog as one sealed segment.
+        - The store listens to Recipe changes. Each save/delete rewrites the
+          (small) delta into a new delta file: segments are never modified in
+          place. Once the delta holds DELTA_MAX recipes it is sealed.
+        - When MERGE_AT sealed segments exist, a background task on the shared
+          ThreadPool merges them into one. The result is installed by poll()
+          on the caller's thread, so readers never see a half-swapped index.
+        - Any change the store did not see (version gap, failed write) marks
+          it stale and the next search rebuilds.
+        - Files no longer listed in the manifest are removed on open/rebuild.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/threadpool.h"
+    #include "recipe.cpp"
+    #include "indexsegment.cpp"
+
+    RecipeIndexStore:
+        private:
+            - DELTA_MAX / MERGE_AT      : Seal and merge thresholds
+            - dir                       : Index directory
+            - sealed / delta            : Mapped segments (oldest first) and delta
+            - opened / current          : Open attempted / segments match recipes.csv
+            - syncedVersion             : Recipe::tableVersion() the segments reflect
+            - generationCounter         : Bumped whenever the segment list changes
+            - nextFile                  : Next segment file number
+            - merging / pendingMerge    : Background merge in flight and its result
+            - fingerprint()             : Size and write time of recipes.csv
+            - nextName(prefix)          : New unique segment file name
+            - writeFile(path, bytes)    : Write through a temp file and rename (static)
+            - writeSegment(name, data)  : Persist and map a segment (memory fallback)
+            - writeManifest()           : Persist the segment list
+            - removeUnreferenced()      : Delete stray segment files
+            - onChange(recipe, removed) : Apply one recipe change to the delta
+            - startMerge()              : Merge sealed segments in the background
+        public:
+            - shared()                  : Process-wide store (static)
+            - open()                    : Map the persisted index
+            - isCurrent()               : Segments reflect the current table
+            - rebuild(recipes)          : Replace the index with a full catalog
+            - poll()                    : Install a finished background merge
+            - view()                    : Segments oldest first (delta last)
+            - generation()              : Changes whenever view() would change
+*/
+class RecipeIndexStore {
+private:
+    static constexpr int DELTA_MAX = 64;                                    // recipes in delta before sealing
+    static constexpr int MERGE_AT = 4;                                      // sealed segments before merging
+
+    string dir = "./data/index/";                                           // index directory
+    vector<shared_ptr<IndexSegment>> sealed;                                // immutable segments, oldest first
+    shared_ptr<IndexSegment> delta;                                         // latest changes (may be null)
+    bool opened = false;                                                    // open() was attempted
+    bool current = false;                                                   // segments match recipes.csv
+    unsigned long long syncedVersion = 0;                                   // table version of segments
+    unsigned long long generationCounter = 0;                               // bumped on segment list change
+    int nextFile = 1;                                                       // next segment file number
+
+    bool merging = false;                                                   // background merge in flight
+    int mergeInputs = 0;                                                    // sealed segments being merged
+    string mergeTarget = "";                                                // merged segment file name
+    future<bool> pendingMerge;                                              // merge result
+
+    RecipeIndexStore() {
+        Recipe::listeners().push_back([this](const Recipe& recipe, bool removed) {
+            onChange(recipe, removed);                                      // keep delta in sync
+        });
+    }
+
+    /*
+        Size and write time of recipes.csv ("" when missing)
+    */
+    string fingerprint() {
+        error_code ec;
+        filesystem::path source("./data/recipes.csv");
+        uintmax_t bytes = filesystem::file_size(source, ec);
+        if (ec) return "";
+        filesystem::file_time_type written = filesystem::last_write_time(source, ec);
+        if (ec) return "";
+        return to_string(bytes) + ":" + to_string(written.time_since_epoch().count());
+    }
+
+    /*
+        New unique segment file name, e.g. seg_000012.idx
+    */
+    string nextName(string prefix) {
+        string number = to_string(nextFile++);
+        while (number.length() < 6) number = "0" + number;
+        return prefix + "_" + number + ".idx";
+    }
+
+    /*
+        Write bytes to a temp file and rename over the target
+    */
+    static bool writeFile(string path, string bytes) {
+        string temp = path + ".tmp";
+        {
+            ofstream file(temp, ios::binary | ios::trunc);
+            if (!file.is_open()) return false;
+            file.write(bytes.data(), streamsize(bytes.size()));
+            if (!file.good()) return false;
+        }
+        error_code ec;
+        filesystem::rename(temp, path, ec);                                 // publish complete file only
+        return !ec;
+    }
+
+    /*
+        Persist and map a segment; keep it in memory if the write fails
+    */
+    shared_ptr<IndexSegment> writeSegment(string name, const SegmentData& data) {
+        string bytes = data.serialize();
+        shared_ptr<IndexSegment> segment = make_shared<IndexSegment>();
+        if (writeFile(dir + name, bytes) && segment->openFile(dir + name)) return segment;
+        segment = make_shared<IndexSegment>();
+        segment->openBuffer(bytes);                                         // path stays "" (not persisted)
+        return segment;
+    }
+
+    /*
+        Persist the segment list (removed when a segment is memory-only)
+    */
+    bool writeManifest() {
+        vector<shared_ptr<IndexSegment>> segments = view();
+        stringstream manifest;
+        manifest << "chefpp-index " << SegmentData::FORMAT << "\n";
+        manifest << "source " << fingerprint() << "\n";
+        manifest << "next " << nextFile << "\n";
+        for (int i = 0; i < segments.size(); i++) {
+            if (segments[i]->path.empty()) {                                // cannot reopen next run
+                error_code ec;
+                filesystem::remove(dir + "manifest.txt", ec);
+                return false;
+            }
+            bool isDelta = segments[i] == delta;
+            string name = filesystem::path(segments[i]->path).filename().string();
+            manifest << (isDelta ? "delta " : "segment ") << name << "\n";
+        }
+        return writeFile(dir + "manifest.txt", manifest.str());
+    }
+
+    /*
+        Delete segment files that the manifest does not reference
+    */
+    void removeUnreferenced() {
+        vector<shared_ptr<IndexSegment>> segments = view();
+        error_code ec;
+        for (filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            string name = it->path().filename().string();
+            if (it->path().extension() != ".idx" && it->path().extension() != ".tmp") continue;
+            if (merging && name == mergeTarget) continue;                   // merge still writing
+            bool used = false;
+            for (int i = 0; i < segments.size(); i++) {
+                if (filesystem::path(segments[i]->path).filename().string() == name) used = true;
+            }
+            error_code rec;
+            if (!used) filesystem::remove(it->path(), rec);
+        }
+    }
+
+    /*
+        Apply one recipe change to a new delta segment
+    */
+    void onChange(const Recipe& recipe, bool removed) {
+        if (!opened) return;                                                // store not in use
+        if (!current || Recipe::tableVersion() != syncedVersion + 1) {      // missed a change
+            current = false;
+            return;
+        }
+        poll();
+
+        SegmentData data;
+        if (delta) delta->loadInto(data, delta->ids(), true);               // carry previous delta forward
+        if (removed) data.remove(uint32_t(recipe.id));
+        else data.add(recipe);
+
+        string previous = delta ? delta->path : "";
+        delta = writeSegment(nextName("delta"), data);                      // never rewrite a live file
+        if (delta->docCount() >= DELTA_MAX) {                               // seal a full delta
+            sealed.push_back(delta);
+            delta.reset();
+        }
+        writeManifest();
+        if (!previous.empty()) {
+            error_code ec;
+            filesystem::remove(previous, ec);                               // old delta is unreferenced
+        }
+        syncedVersion = Recipe::tableVersion();
+        generationCounter++;
+        if (sealed.size() >= MERGE_AT) startMerge();
+    }
+
+    /*
+        Merge every sealed segment into one on the thread pool
+    */
+    void startMerge() {
+        if (merging) return;
+        vector<shared_ptr<IndexSegment>> inputs = sealed;                   // segments are immutable
+        mergeInputs = int(inputs.size());
+        mergeTarget = nextName("seg");
+        string path = dir + mergeTarget;
+        merging = true;
+        pendingMerge = ThreadPool::shared().submit([inputs, path]() -> bool {
+            SegmentData data;
+            Bitmap shadow;                                                  // ids owned by newer inputs
+            for (int i = int(inputs.size()) - 1; i >= 0; i--) {
+                Bitmap ids = inputs[i]->ids();
+                inputs[i]->loadInto(data, ids.andNot(shadow), false);       // oldest input: tombstones drop
+                shadow = shadow.orWith(ids).orWith(inputs[i]->tombstones());
+            }
+            return writeFile(path, data.serialize());
+        });
+    }
+
+public:
+    /*
+        Process-wide store
+    */
+    static RecipeIndexStore& shared() {
+        static RecipeIndexStore store;                                      // created on first use
+        return store;
+    }
+
+    /*
+        Map the persisted index (false when missing or stale)
+    */
+    bool open() {
+        if (opened) return current;
+        opened = true;
+        current = false;
+        syncedVersion = Recipe::tableVersion();
+
+        ifstream file(dir + "manifest.txt");
+        if (!file.is_open()) return false;                                  // never built
+        string line;
+        vector<shared_ptr<IndexSegment>> segments;
+        shared_ptr<IndexSegment> latest;
+        bool sourceMatches = false;
+        while (getline(file, line)) {
+            stringstream fields(line);
+            string key; string value;
+            fields >> key;
+            getline(fields, value);
+            value = out.trim(value);
+            if (key == "chefpp-index" && value != to_string(SegmentData::FORMAT)) return false;
+            if (key == "source") sourceMatches = !value.empty() && value == fingerprint();
+            if (key == "next") { try { nextFile = stoi(value); } catch (...) { return false; } }
+            if (key == "segment" || key == "delta") {
+                shared_ptr<IndexSegment> segment = make_shared<IndexSegment>();
+                if (!segment->openFile(dir + value)) return false;          // missing or corrupt
+                if (key == "delta") latest = segment; else segments.push_back(segment);
+            }
+        }
+        if (!sourceMatches) return false;                                   // recipes.csv changed
+        sealed = segments;
+        delta = latest;
+        current = true;
+        generationCounter++;
+        removeUnreferenced();
+        return true;
+    }
+
+    /*
+        Segments reflect the current recipe table
+    */
+    bool isCurrent() {
+        if (!opened) open();
+        return current && syncedVersion == Recipe::tableVersion();
+    }
+
+    /*
+        Replace the index with a full catalog
+    */
+    void rebuild(vector<Recipe>& recipes) {
+        opened = true;
+        if (merging) {                                                      // inputs are being replaced
+            pendingMerge.wait();
+            merging = false;
+        }
+        error_code ec;
+        filesystem::create_directories(dir, ec);
+
+        SegmentData data;
+        for (int i = 0; i < recipes.size(); i++) data.add(recipes[i]);
+        sealed = { writeSegment(nextName("seg"), data) };
+        delta.reset();
+        writeManifest();
+        removeUnreferenced();
+        syncedVersion = Recipe::tableVersion();
+        current = true;
+        generationCounter++;
+    }
+
+    /*
+        Install a finished background merge
+    */
+    void poll() {
+        if (!merging) return;
+        if (pendingMerge.wait_for(chrono::seconds(0)) != future_status::ready) return;
+        merging = false;
+        if (!pendingMerge.get()) return;                                    // write failed, keep inputs
+
+        shared_ptr<IndexSegment> merged = make_shared<IndexSegment>();
+        if (!merged->openFile(dir + mergeTarget)) return;
+        vector<string> replaced;
+        for (int i = 0; i < mergeInputs; i++) replaced.push_back(sealed[i]->path);
+        sealed.erase(sealed.begin(), sealed.begin() + mergeInputs);
+        sealed.insert(sealed.begin(), merged);
+        writeManifest();
+        for (int i = 0; i < replaced.size(); i++) {
+            error_code ec;
+            if (!replaced[i].empty()) filesystem::remove(replaced[i], ec);
+        }
+        generationCounter++;
+    }
+
+    /*
+        Segments oldest first, delta last
+    */
+    vector<shared_ptr<IndexSegment>> view() {
+        vector<shared_ptr<IndexSegment>> segments = sealed;
+        if (delta) segments.push_back(delta);
+        return segments;
+    }
+
+    unsigned long long generation() const { return generationCounter; }
+};
+
+#endif // INDEXSTORE_H
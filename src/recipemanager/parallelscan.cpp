@@ -0,0 +1,92 @@
+#ifndef PARALLELSCAN_H
+#define PARALLELSCAN_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/bitmap.h"
+#include "../../vendor/sys/threadpool.h"
+#include "recipe.cpp"
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+/*
+    ParallelScan Struct
+
+    Scan executor for search predicates that have no index (for example a
+    substring anywhere in the instructions). The catalog is split into
+    contiguous chunks that are evaluated on the shared ThreadPool.
+
+    How it works:
+        - run() hands each worker a [begin, end) slice of the catalog.
+        - A worker only reads recipes and appends matching ids to its own
+          output vector, so there is no shared mutable state or locking.
+        - Each chunk's ids are sorted, then the chunks are k-way merged so
+          the result Bitmap is built with ascending (append-only) inserts.
+        - Predicates must be safe to call concurrently (capture by value,
+          no writes to captured state).
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/bitmap.h"
+    #include "../../vendor/sys/threadpool.h"
+    #include "recipe.cpp"
+
+    ParallelScan:
+        public:
+            - Predicate                         : bool(const Recipe&)
+            - run(catalog, predicate)           : Ids of matching recipes (static)
+            - instructionsContain(text)         : Case-insensitive instructions substring predicate (static)
+*/
+struct ParallelScan {
+public:
+    typedef function<bool(const Recipe&)> Predicate;
+
+    /*
+        Evaluate predicate over the catalog and return matching ids
+    */
+    static Bitmap run(const vector<Recipe>& catalog, Predicate predicate) {
+        ThreadPool& pool = ThreadPool::shared();
+        vector<vector<uint32_t>> partial(pool.size());                      // one output per chunk
+
+        int used = pool.parallelFor(catalog.size(), [&catalog, &partial, predicate](int chunk, size_t begin, size_t end) {
+            vector<uint32_t>& local = partial[chunk];                       // chunk-owned output
+            for (size_t i = begin; i < end; i++) {
+                if (catalog[i].id > 0 && predicate(catalog[i])) {
+                    local.push_back(uint32_t(catalog[i].id));
+                }
+            }
+            sort(local.begin(), local.end());                               // ids in chunk order
+        }, 256);
+
+        Bitmap result;
+        vector<size_t> cursor(used, 0);
+        while (true) {                                                      // k-way merge by id
+            int best = -1;
+            for (int c = 0; c < used; c++) {
+                if (cursor[c] >= partial[c].size()) continue;
+                if (best == -1 || partial[c][cursor[c]] < partial[best][cursor[best]]) best = c;
+            }
+            if (best == -1) break;                                          // every chunk drained
+            result.add(partial[best][cursor[best]++]);                      // ascending insert
+        }
+        return result;
+    }
+
+    /*
+        Predicate matching recipes whose instructions contain the text
+    */
+    static Predicate instructionsContain(string text) {
+        string needle = out.toLowerCase(out.trim(text));
+        return [needle](const Recipe& r) {
+            if (needle.empty()) return true;                                // empty text matches all
+            auto it = search(r.instructions.begin(), r.instructions.end(), needle.begin(), needle.end(),
+                [](char a, char b) { return tolower(static_cast<unsigned char>(a)) == b; });
+            return it != r.instructions.end();
+        };
+    }
+};
+
+#endif // PARALLELSCAN_H
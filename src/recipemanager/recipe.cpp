@@ -5,6 +5,8 @@
 #include "../../vendor/sys/csv.h"
 #include <vector>
 #include <string>
+#include <functional>
+#include <unordered_set>
 
 using namespace std;
 
@@ -19,8 +21,11 @@ using namespace std;
         - persist recipes to the `recipes.csv` file and load all recipes
 
     Data contract / CSV layout:
-        Current CSV row format (4 columns):
-            [id, name, ingredients, instructions]
+        Current CSV row format (4 or 5 columns):
+            [id, name, ingredients, instructions, servings]
+        servings is the number of servings the ingredient amounts make. It
+        is optional: rows without it (or with 0) have unknown base servings
+        and are never scaled.
 
         Legacy CSV row format (3 columns):
             [name, ingredients, instructions]
@@ -38,6 +43,19 @@ using namespace std;
 
         When writing to CSV the ingredients vector is joined with a semicolon
         separator into the `ingredients` field of the CSV row.
+
+    Table version:
+        tableVersion() is an in-process counter bumped whenever recipes.csv is
+        rewritten (save, delete, legacy migration). Caches and indexes built
+        from the recipe table remember the version they were built at and are
+        stale once it changes.
+
+    Change listeners:
+        listeners() holds callbacks run after save() or deleteById() has
+        rewritten recipes.csv, with the affected recipe and whether it was
+        removed (only the id is set for removals). Listeners run after
+        tableVersion() is bumped; migrations do not notify, so a listener that
+        sees the version jump by more than one knows it missed a change.
 */
 
 struct Recipe {
@@ -46,6 +64,7 @@ public:
     string name;
     vector<string> ingredients;
     string instructions;
+    int servings = 0;                                                      // servings the amounts make (0 = unknown)
 
     /*
         Constructors
@@ -68,6 +87,35 @@ public:
     Recipe(int i, string n, vector<string> ing, string inst)
         : id(i), name(n), ingredients(ing), instructions(inst) {}
 
+    /*
+        tableVersion()
+
+        Purpose:
+            Counter identifying the current contents of recipes.csv.
+            Incremented by every write performed through this struct.
+    */
+    static unsigned long long& tableVersion() {
+        static unsigned long long version = 0;                              // bumped on every write
+        return version;
+    }
+
+    /*
+        listeners() / notifyChange(recipe, removed)
+
+        Purpose:
+            Callbacks told about each recipe written or deleted through
+            this struct (see "Change listeners" above).
+    */
+    static vector<function<void(const Recipe&, bool)>>& listeners() {
+        static vector<function<void(const Recipe&, bool)>> hooks;           // registered callbacks
+        return hooks;
+    }
+
+    static void notifyChange(const Recipe& recipe, bool removed) {
+        vector<function<void(const Recipe&, bool)>>& hooks = listeners();
+        for (int i = 0; i < hooks.size(); i++) hooks[i](recipe, removed);   // run in registration order
+    }
+
     /*
         displayPreview()
 
@@ -96,6 +144,9 @@ public:
             out.coutln("ID: " + to_string(id));                           // display id if available
         }
         out.coutln("Recipe: " + name);
+        if (servings > 0) {
+            out.coutln("Servings: " + to_string(servings));               // display base servings if known
+        }
         out.br();
         out.coutln("Ingredients:");
         for (int i = 0; i < ingredients.size(); i++) {                    // iterate over ingredients
@@ -158,6 +209,22 @@ public:
         out.br();
     }
 
+    /*
+        scaleFor(int base, int wanted)
+
+        Purpose:
+            Factor that turns the amounts of a recipe making `base` servings
+            into amounts for `wanted` servings.
+
+        Notes:
+            - Returns 1 when either side is unknown (<= 0), so recipes
+              without base servings are used as written.
+    */
+    static double scaleFor(int base, int wanted) {
+        if (base <= 0 || wanted <= 0) return 1.0;                         // unknown: use amounts as written
+        return double(wanted) / double(base);
+    }
+
     /*
         parseIngredients(string ingredientsInput)
 
@@ -269,6 +336,38 @@ public:
         return result;                                                     // return parsed ingredients
     }
 
+    /*
+        splitIngredient(string token, string& name, string& amount, string& unit)
+
+        Purpose:
+            Split one stored ingredient token into its name, amount and unit.
+
+        Behavior:
+            - Accepts "name|amount|unit" (stored form) or "name:amount:unit".
+            - Tokens without measurement information yield only a name;
+              amount and unit are set to "".
+    */
+    static void splitIngredient(string token, string& name, string& amount, string& unit) {
+        int sep1 = -1; int sep2 = -1; char separator = ' ';
+        for (int i = 0; i < token.length(); i++) {                         // find separator type
+            if (token[i] == '|') { sep1 = i; separator = '|'; break; }
+            if (token[i] == ':') { sep1 = i; separator = ':'; break; }
+        }
+        if (sep1 != -1) {                                                  // first separator found
+            for (int i = sep1 + 1; i < token.length(); i++) {              // find second separator
+                if (token[i] == separator) { sep2 = i; break; }
+            }
+        }
+        if (sep1 != -1 && sep2 != -1) {                                    // full form present
+            name = out.trim(token.substr(0, sep1));
+            amount = out.trim(token.substr(sep1 + 1, sep2 - sep1 - 1));
+            unit = out.trim(token.substr(sep2 + 1));
+        } else {
+            name = out.trim(token);                                        // only name available
+            amount = ""; unit = "";
+        }
+    }
+
     /*
         toCSVRow()
 
@@ -297,6 +396,7 @@ public:
         row.push_back(ingredientsStr);                                      // add ingredients as one field
         
         row.push_back(instructions);                                        // add instructions
+        if (servings > 0) row.push_back(to_string(servings));               // optional base servings
         return row;                                                         // return CSV row
     }
 
@@ -344,6 +444,14 @@ public:
             }
             
             recipe.instructions = row[3];                                   // get instructions
+            if (row.size() >= 5) {                                          // optional base servings
+                try {
+                    recipe.servings = stoi(row[4]);
+                    if (recipe.servings < 0) recipe.servings = 0;
+                } catch (...) {
+                    recipe.servings = 0;
+                }
+            }
         } else if (row.size() >= 3) {                                       // legacy format: name,ingredients,instructions
             recipe.id = 0;                                                  // id unknown in legacy row
             recipe.name = row[0];
@@ -409,6 +517,7 @@ public:
                 nid++;
             }
             csv.write(newdata);                                            // write migrated data
+            tableVersion()++;                                              // ids were assigned
             data = newdata;                                                // use migrated data
         }
 
@@ -428,6 +537,8 @@ public:
 
         // Write back to file
         if (csv.write(data)) {                                              // write all recipes to file
+            tableVersion()++;                                               // table changed
+            notifyChange(*this, false);                                     // tell listeners
             out.coutln("Recipe '" + name + "' added successfully!");        // success message
         } else {
             out.coutln("Error: Could not save recipe.");                    // error message
@@ -474,6 +585,7 @@ public:
                 nid2++;
             }
             csv.write(newdata2);
+            tableVersion()++;                                              // ids were assigned
             data = newdata2;
         }
 
@@ -509,6 +621,36 @@ public:
         return Recipe();                                                   // not found
     }
 
+    /*
+        findByIds(const vector<int>& ids)
+
+        Purpose:
+            Fetch several recipes with one read of recipes.csv (e.g. every
+            recipe of a week's meal plan) instead of one loadAll() per id.
+
+        Behavior:
+            - Only rows whose id is requested are converted to Recipe.
+            - Returns the recipes found, in file order; unknown ids are
+              skipped and duplicates are returned once.
+
+        Complexity: O(N) for one pass over the file, independent of the
+        number of ids requested.
+    */
+    static vector<Recipe> findByIds(const vector<int>& ids) {
+        unordered_set<int> wanted(ids.begin(), ids.end());                 // hash set of requested ids
+        vector<Recipe> found;
+        if (wanted.empty()) return found;                                   // nothing requested
+        CSV csv("recipes.csv");                                             // open recipes CSV file
+        vector<vector<string>> data = csv.read();                           // single read
+        for (int i = 0; i < data.size() && found.size() < wanted.size(); i++) {
+            if (data[i].size() < 4) continue;                               // legacy or empty row
+            int rid = 0;
+            try { rid = stoi(data[i][0]); } catch (...) { continue; }
+            if (wanted.count(rid)) found.push_back(fromCSVRow(data[i]));    // parse matches only
+        }
+        return found;
+    }
+
     /*
         deleteById(int id)
 
@@ -548,6 +690,10 @@ public:
 
         if (found) {                                                        // recipe was found and removed
             csv.write(newData);                                             // write filtered data back to file
+            tableVersion()++;                                               // table changed
+            Recipe removed;
+            removed.id = id;
+            notifyChange(removed, true);                                    // tell listeners
             return true;                                                    // deletion successful
         }
         return false;                                                       // recipe not found
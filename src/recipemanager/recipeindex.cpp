@@ -0,0 +1,157 @@
+#ifndef RECIPEINDEX_H
+#define RECIPEINDEX_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/bitmap.h"
+#include "recipe.cpp"
+#include "indexsegment.cpp"
+#include <vector>
+#include <string>
+#include <memory>
+
+using namespace std;
+
+/*
+    RecipeIndex Struct
+
+    Inverted index over the recipe catalog used by SearchRecipePage. Each
+    searchable term maps to recipe ids, so a query is answered with bitmap
+    operations rather than by re-reading and scanning recipes.csv.
+
+    How it works:
+        - The index is a stack of IndexSegments (oldest first). Segments are
+          usually memory-mapped files from RecipeIndexStore; build() makes a
+          single in-memory segment straight from a catalog instead.
+        - Two fields are indexed per recipe:
+            * name words (lowercased, split on non-alphanumerics)
+            * ingredient names (lowercased name part of "name|amount|unit")
+        - attach() computes which ids each segment still owns: a newer
+          segment shadows the same id (or a tombstone) in older ones.
+        - Lookups keep the substring semantics of the old linear search by
+          scanning each segment's term vocabulary (distinct words), which is
+          far smaller than the recipe table, and OR-ing matching postings.
+        - A multi-word name query matches when every query word is found in
+          some word of the recipe name.
+        - `all` holds every live id and is the universe for NOT.
+        - Only recipe names are stored per id (for rendering result pages);
+          full recipes are fetched on demand with Recipe::findById().
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/bitmap.h"
+    #include "recipe.cpp"
+    #include "indexsegment.cpp"
+
+    RecipeIndex:
+        public:
+            - all                       : Bitmap of every indexed recipe id
+            - maxId                     : Largest indexed recipe id
+            - segments                  : Segments, oldest first
+            - live                      : Ids each segment still owns
+            - build(recipes)            : Index a catalog in memory
+            - attach(segments)          : Use prebuilt (mapped) segments
+            - matchName(query)          : Ids whose name contains the query words
+            - matchIngredient(query)    : Ids having an ingredient containing the query
+            - matchIdRange(lo, hi)      : Indexed ids within [lo, hi]
+            - nameOf(id)                : Recipe name for an indexed id
+            - tokenize(text)            : Lowercase word split (static)
+*/
+struct RecipeIndex {
+public:
+    Bitmap all;                                                             // every recipe id
+    int maxId = 0;                                                          // largest indexed id
+    vector<shared_ptr<IndexSegment>> segments;                              // oldest first
+    vector<Bitmap> live;                                                    // ids owned per segment
+
+    /*
+        Split text into lowercase alphanumeric words
+    */
+    static vector<string> tokenize(string text) {
+        return SegmentData::tokenize(text);
+    }
+
+    /*
+        Index a catalog as one in-memory segment
+    */
+    void build(vector<Recipe>& recipes) {
+        SegmentData data;
+        for (int i = 0; i < recipes.size(); i++) data.add(recipes[i]);      // fill postings
+        shared_ptr<IndexSegment> segment = make_shared<IndexSegment>();
+        segment->openBuffer(data.serialize());
+        attach({ segment });
+    }
+
+    /*
+        Use prebuilt segments (oldest first)
+    */
+    void attach(vector<shared_ptr<IndexSegment>> segs) {
+        segments = segs;
+        live.assign(segments.size(), Bitmap());
+        all = Bitmap();
+        Bitmap shadow;                                                      // ids claimed by newer segments
+        for (int i = int(segments.size()) - 1; i >= 0; i--) {
+            Bitmap ids = segments[i]->ids();
+            live[i] = ids.andNot(shadow);
+            all = all.orWith(live[i]);
+            shadow = shadow.orWith(ids).orWith(segments[i]->tombstones());
+        }
+        vector<uint32_t> values = all.toVector();
+        maxId = values.empty() ? 0 : int(values.back());
+    }
+
+    /*
+        Union over segments of live ids with a term containing the needle
+    */
+    Bitmap matchTerms(IndexSegment::Field field, string needle) {
+        Bitmap result;
+        for (int i = 0; i < segments.size(); i++) {
+            result = result.orWith(segments[i]->match(field, needle).andWith(live[i]));
+        }
+        return result;
+    }
+
+    /*
+        Ids whose name contains every query word
+    */
+    Bitmap matchName(string query) {
+        vector<string> words = tokenize(query);
+        if (words.empty()) { return all; }                                  // empty query matches all
+        Bitmap result = matchTerms(IndexSegment::FIELD_NAME, words[0]);
+        for (int i = 1; i < words.size() && !result.empty(); i++) {
+            result = result.andWith(matchTerms(IndexSegment::FIELD_NAME, words[i]));   // AND word postings
+        }
+        return result;
+    }
+
+    /*
+        Ids having an ingredient whose name contains the query
+    */
+    Bitmap matchIngredient(string query) {
+        string needle = out.toLowerCase(out.trim(query));
+        if (needle.empty()) { return all; }                                 // empty query matches all
+        return matchTerms(IndexSegment::FIELD_INGREDIENT, needle);
+    }
+
+    /*
+        Indexed ids within [lo, hi]
+    */
+    Bitmap matchIdRange(int lo, int hi) {
+        if (lo < 0) { lo = 0; }
+        if (hi > maxId) { hi = maxId; }                                     // clamp open-ended ranges
+        if (hi < lo) { return Bitmap(); }                                   // empty range
+        return all.andWith(Bitmap::range(uint32_t(lo), uint32_t(hi)));
+    }
+
+    /*
+        Recipe name for an indexed id ("" when unknown)
+    */
+    string nameOf(int id) {
+        string name = "";
+        for (int i = int(segments.size()) - 1; i >= 0; i--) {               // newest owner wins
+            if (live[i].contains(uint32_t(id)) && segments[i]->nameOf(uint32_t(id), name)) return name;
+        }
+        return "";
+    }
+};
+
+#endif // RECIPEINDEX_H
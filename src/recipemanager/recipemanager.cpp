@@ -4,6 +4,7 @@
 #include "addrecipe.cpp"
 #include "searchrecipe.cpp"
 #include "deleterecipe.cpp"
+#include "indexstore.cpp"
 
 /*
     RecipeManagerPage Class
@@ -19,6 +20,9 @@
           options vector with labeled actions and their callbacks.
         - Selecting an option may open another Page (navigates and returns)
           or a Modal (performs its task and auto-returns).
+        - The constructor also opens the persisted search index
+          (RecipeIndexStore) so it maps existing segments and tracks every
+          recipe saved or deleted from here on.
 
     Header classes:
     #include "../../vendor/sys/out.h"
@@ -26,6 +30,7 @@
     #include "addrecipe.cpp"          // AddRecipeModal (modal)
     #include "searchrecipe.cpp"       // SearchRecipePage (page)
     #include "deleterecipe.cpp"       // DeleteRecipeModal (modal)
+    #include "indexstore.cpp"         // RecipeIndexStore (search index files)
 
     Options:
         - "Add Recipe"        : Opens AddRecipeModal (collect → confirm → save → return)
@@ -47,25 +52,23 @@ public:
         this->header = "Recipe Manager";              // page header text
         this->showheader = true;                       // show the header
         this->useExitInsteadOfBack = false;            // show "Back" instead of "Exit"
+        RecipeIndexStore::shared().open();             // map search index segments (no rebuild)
 
         // Populate the options vector with labeled actions
         this->options = {
             // Open the Add Recipe flow (modal). After finishing, it auto-returns here.
             Options("Add Recipe", []() {
-                AddRecipeModal addRecipeModal;        // instantiate modal by value
-                addRecipeModal.init();                // run modal and return
+                Navigator::shared().open(new AddRecipeModal()); // run modal and return
             }),
 
             // Open the Search Recipe page (can view recipe in a modal, or research)
             Options("Search Recipe", []() {
-                SearchRecipePage searchPage;          // instantiate page by value
-                searchPage.init();                    // navigate into page
+                Navigator::shared().open(new SearchRecipePage()); // navigate into page
             }),
 
             // Open the Delete Recipe flow (modal). Prompts for ID, confirms, and deletes.
             Options("Delete Recipe", []() {
-                DeleteRecipeModal deleteRecipeModal;  // instantiate modal by value
-                deleteRecipeModal.init();             // run modal and return
+                Navigator::shared().open(new DeleteRecipeModal()); // run modal and return
             }),
         };
     }
@@ -78,4 +81,10 @@ public:
     */
     void schema() override {}
 
+    /*
+        Menu only - the frame never changes, so it is drawn once
+    */
+    unsigned long long dataVersion() override {
+        return 1;
+    }
 };
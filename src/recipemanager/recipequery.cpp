@@ -0,0 +1,309 @@
+#ifndef RECIPEQUERY_H
+#define RECIPEQUERY_H
+
+#include "../../vendor/sys/out.h"
+#include "../../vendor/sys/bitmap.h"
+#include "recipeindex.cpp"
+#include <vector>
+#include <string>
+#include <functional>
+
+using namespace std;
+
+/*
+    RecipeQuery Struct
+
+    Small boolean query language for recipe search, compiled into a plan of
+    bitmap operations and evaluated against a RecipeIndex.
+
+    Syntax:
+        query   := orExpr
+        orExpr  := andExpr ( OR andExpr )*
+        andExpr := unary ( [AND] unary )*           (adjacent terms are AND-ed)
+        unary   := NOT unary | "(" orExpr ")" | term
+        term    := name:value | ingredient:value | instructions:value | id:N | id:N..M | value
+        value   := word | "quoted words"
+
+        Keywords are case-insensitive. A bare value searches recipe names.
+        Field aliases: n/name, i/ing/ingredient, t/text/instructions, id.
+        Instructions are not indexed; those terms are answered by the scan
+        callback passed to evaluate() (see ParallelScan).
+
+        Example:
+            ingredient:garlic AND NOT ingredient:peanut AND name:soup AND id:100..200
+
+    How it works:
+        - parse() tokenizes the text and builds a small expression tree.
+        - The tree is compiled to a postfix plan. "x AND NOT y" becomes a single
+          ANDNOT step so negations never materialize the complement; a lone
+          NOT is evaluated as ALL ANDNOT y.
+        - evaluate() runs the plan on a stack of Bitmaps.
+        - describe() renders the compiled plan for display.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/bitmap.h"
+    #include "recipeindex.cpp"
+
+    RecipeQuery:
+        private:
+            - Node / nodes              : Parsed expression tree
+            - tokens / pos              : Tokenizer output and parse cursor
+            - tokenize(text)            : Split query into tokens
+            - parseOr/And/Unary/Term()  : Recursive descent parser
+            - compile(node)             : Emit postfix plan for a node
+        public:
+            - Step / plan               : Compiled postfix plan
+            - error                     : Parse error message (empty when valid)
+            - parse(text)               : Parse and compile (false on error)
+            - evaluate(index, scan)     : Run plan and return matching ids
+            - describe()                : Human readable plan
+*/
+struct RecipeQuery {
+public:
+    enum StepOp { LOAD_NAME, LOAD_INGREDIENT, LOAD_INSTRUCTIONS, LOAD_ID_RANGE, LOAD_ALL, AND, OR, ANDNOT };
+
+    struct Step {
+        StepOp op;
+        string text;                                                        // term text (name/ingredient/instructions)
+        int lo = 0;                                                         // id range start
+        int hi = 0;                                                         // id range end
+    };
+
+    vector<Step> plan;                                                      // postfix plan
+    string error;                                                           // parse error message
+
+private:
+    enum NodeKind { N_NAME, N_INGREDIENT, N_INSTRUCTIONS, N_ID, N_AND, N_OR, N_NOT };
+
+    struct Node {
+        NodeKind kind;
+        string text;
+        int lo = 0; int hi = 0;
+        int left = -1; int right = -1;                                      // child node indexes
+    };
+
+    vector<Node> nodes;                                                     // expression tree storage
+    vector<string> tokens;                                                  // tokenized query
+    int pos = 0;                                                            // parse cursor
+
+    /*
+        Split query into words, parentheses and quoted values
+    */
+    void tokenize(string text) {
+        tokens.clear();
+        string current = "";
+        bool inQuotes = false;
+        for (int i = 0; i < text.length(); i++) {
+            char c = text[i];
+            if (c == '"') {                                                 // toggle quoted value
+                inQuotes = !inQuotes;
+                current += c;
+            } else if (!inQuotes && (c == ' ' || c == '\t')) {              // whitespace splits tokens
+                if (!current.empty()) { tokens.push_back(current); current = ""; }
+            } else if (!inQuotes && (c == '(' || c == ')')) {               // parentheses are own tokens
+                if (!current.empty()) { tokens.push_back(current); current = ""; }
+                tokens.push_back(string(1, c));
+            } else {
+                current += c;
+            }
+        }
+        if (!current.empty()) tokens.push_back(current);
+        if (inQuotes) error = "Unterminated quote.";
+    }
+
+    bool isKeyword(string token, string keyword) {
+        return out.toLowerCase(token) == out.toLowerCase(keyword);
+    }
+
+    bool atEnd() { return pos >= tokens.size(); }
+
+    int addNode(Node n) {
+        nodes.push_back(n);
+        return int(nodes.size()) - 1;
+    }
+
+    int parseOr() {
+        int left = parseAnd();
+        while (left != -1 && !atEnd() && isKeyword(tokens[pos], "OR")) {
+            pos++;
+            int right = parseAnd();
+            if (right == -1) return -1;
+            Node n; n.kind = N_OR; n.left = left; n.right = right;
+            left = addNode(n);
+        }
+        return left;
+    }
+
+    int parseAnd() {
+        int left = parseUnary();
+        while (left != -1 && !atEnd() && tokens[pos] != ")" && !isKeyword(tokens[pos], "OR")) {
+            if (isKeyword(tokens[pos], "AND")) { pos++; }                   // explicit AND is optional
+            int right = parseUnary();
+            if (right == -1) return -1;
+            Node n; n.kind = N_AND; n.left = left; n.right = right;
+            left = addNode(n);
+        }
+        return left;
+    }
+
+    int parseUnary() {
+        if (atEnd()) { error = "Unexpected end of query."; return -1; }
+        if (isKeyword(tokens[pos], "NOT")) {                                // negation
+            pos++;
+            int child = parseUnary();
+            if (child == -1) return -1;
+            Node n; n.kind = N_NOT; n.left = child;
+            return addNode(n);
+        }
+        if (tokens[pos] == "(") {                                           // grouped expression
+            pos++;
+            int inner = parseOr();
+            if (inner == -1) return -1;
+            if (atEnd() || tokens[pos] != ")") { error = "Missing ')'."; return -1; }
+            pos++;
+            return inner;
+        }
+        if (tokens[pos] == ")") { error = "Unexpected ')'."; return -1; }
+        if (isKeyword(tokens[pos], "AND") || isKeyword(tokens[pos], "OR")) {
+            error = "Expected a term before '" + tokens[pos] + "'.";
+            return -1;
+        }
+        return parseTerm(tokens[pos++]);
+    }
+
+    int parseTerm(string token) {
+        string field = "name";
+        string value = token;
+        int colon = token.find(':');
+        if (colon != string::npos && token[0] != '"') {                     // field:value form
+            field = out.toLowerCase(token.substr(0, colon));
+            value = token.substr(colon + 1);
+        }
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);                      // strip quotes
+        }
+        value = out.trim(value);
+        if (value.empty()) { error = "Missing value for '" + field + "'."; return -1; }
+
+        Node n;
+        if (field == "name" || field == "n") {
+            n.kind = N_NAME; n.text = value;
+        } else if (field == "ingredient" || field == "ing" || field == "i") {
+            n.kind = N_INGREDIENT; n.text = value;
+        } else if (field == "instructions" || field == "text" || field == "t") {
+            n.kind = N_INSTRUCTIONS; n.text = value;
+        } else if (field == "id") {
+            n.kind = N_ID;
+            int dots = value.find("..");
+            string a = dots == string::npos ? value : value.substr(0, dots);
+            string b = dots == string::npos ? value : value.substr(dots + 2);
+            try {
+                n.lo = a.empty() ? 0 : stoi(a);                             // open start: id:..200
+                n.hi = b.empty() ? 2147483647 : stoi(b);                    // open end: id:100..
+            } catch (...) {
+                error = "Invalid id value '" + value + "'.";
+                return -1;
+            }
+            n.text = value;
+        } else {
+            error = "Unknown field '" + field + "'.";
+            return -1;
+        }
+        return addNode(n);
+    }
+
+    /*
+        Emit postfix steps for a node
+    */
+    void compile(int idx) {
+        Node n = nodes[idx];
+        Step s;
+        if (n.kind == N_NAME) { s.op = LOAD_NAME; s.text = n.text; plan.push_back(s); return; }
+        if (n.kind == N_INGREDIENT) { s.op = LOAD_INGREDIENT; s.text = n.text; plan.push_back(s); return; }
+        if (n.kind == N_INSTRUCTIONS) { s.op = LOAD_INSTRUCTIONS; s.text = n.text; plan.push_back(s); return; }
+        if (n.kind == N_ID) { s.op = LOAD_ID_RANGE; s.lo = n.lo; s.hi = n.hi; plan.push_back(s); return; }
+        if (n.kind == N_NOT) {                                              // lone NOT: ALL ANDNOT x
+            s.op = LOAD_ALL; plan.push_back(s);
+            compile(n.left);
+            s.op = ANDNOT; plan.push_back(s);
+            return;
+        }
+        if (n.kind == N_AND && nodes[n.right].kind == N_NOT) {              // x AND NOT y -> ANDNOT
+            compile(n.left);
+            compile(nodes[n.right].left);
+            s.op = ANDNOT; plan.push_back(s);
+            return;
+        }
+        if (n.kind == N_AND && nodes[n.left].kind == N_NOT) {               // NOT y AND x -> ANDNOT
+            compile(n.right);
+            compile(nodes[n.left].left);
+            s.op = ANDNOT; plan.push_back(s);
+            return;
+        }
+        compile(n.left);
+        compile(n.right);
+        s.op = n.kind == N_AND ? AND : OR;
+        plan.push_back(s);
+    }
+
+public:
+    /*
+        Parse and compile query text
+    */
+    bool parse(string text) {
+        plan.clear(); nodes.clear(); error = ""; pos = 0;
+        tokenize(text);
+        if (!error.empty()) return false;
+        if (tokens.empty()) { error = "Empty query."; return false; }
+        int root = parseOr();
+        if (root == -1) return false;
+        if (!atEnd()) { error = "Unexpected '" + tokens[pos] + "'."; plan.clear(); return false; }
+        compile(root);
+        return true;
+    }
+
+    /*
+        Run the plan against the index
+            - scan: answers unindexed instructions terms (no match when null)
+    */
+    Bitmap evaluate(RecipeIndex& index, function<Bitmap(string)> scan = nullptr) {
+        vector<Bitmap> stack;
+        for (int i = 0; i < plan.size(); i++) {
+            Step s = plan[i];
+            if (s.op == LOAD_NAME) { stack.push_back(index.matchName(s.text)); continue; }
+            if (s.op == LOAD_INGREDIENT) { stack.push_back(index.matchIngredient(s.text)); continue; }
+            if (s.op == LOAD_INSTRUCTIONS) { stack.push_back(scan ? scan(s.text) : Bitmap()); continue; }
+            if (s.op == LOAD_ID_RANGE) { stack.push_back(index.matchIdRange(s.lo, s.hi)); continue; }
+            if (s.op == LOAD_ALL) { stack.push_back(index.all); continue; }
+            Bitmap right = stack.back(); stack.pop_back();                  // binary operator
+            Bitmap left = stack.back(); stack.pop_back();
+            if (s.op == AND) stack.push_back(left.andWith(right));
+            else if (s.op == OR) stack.push_back(left.orWith(right));
+            else stack.push_back(left.andNot(right));
+        }
+        return stack.empty() ? Bitmap() : stack.back();
+    }
+
+    /*
+        Render compiled plan, e.g. ANDNOT(AND(name~soup, id[1..5]), ing~peanut)
+    */
+    string describe() {
+        vector<string> stack;
+        for (int i = 0; i < plan.size(); i++) {
+            Step s = plan[i];
+            if (s.op == LOAD_NAME) { stack.push_back("name~" + s.text); continue; }
+            if (s.op == LOAD_INGREDIENT) { stack.push_back("ing~" + s.text); continue; }
+            if (s.op == LOAD_INSTRUCTIONS) { stack.push_back("scan(text~" + s.text + ")"); continue; }
+            if (s.op == LOAD_ID_RANGE) { stack.push_back("id[" + to_string(s.lo) + ".." + to_string(s.hi) + "]"); continue; }
+            if (s.op == LOAD_ALL) { stack.push_back("ALL"); continue; }
+            string right = stack.back(); stack.pop_back();
+            string left = stack.back(); stack.pop_back();
+            string name = s.op == AND ? "AND" : s.op == OR ? "OR" : "ANDNOT";
+            stack.push_back(name + "(" + left + ", " + right + ")");
+        }
+        return stack.empty() ? "" : stack.back();
+    }
+};
+
+#endif // RECIPEQUERY_H
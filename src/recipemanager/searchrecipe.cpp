@@ -1,6 +1,12 @@
 #include "../../vendor/sys/out.h"
 #include "../../vendor/base/page.h"
+#include "../../vendor/sys/lru.h"
 #include "recipe.cpp"
+#include "recipeindex.cpp"
+#include "indexstore.cpp"
+#include "recipequery.cpp"
+#include "similarrecipes.cpp"
+#include "parallelscan.cpp"
 #include "viewrecipe.cpp"
 #include "deleterecipe.cpp"
 #include <vector>
@@ -14,30 +20,79 @@
     It displays search results and allows viewing individual recipes.
 
     How it works:
-        - User selects search type (by name, by ingredients, or by id)
+        - User selects search type (by name, by ingredients, by id, instructions,
+          or a query)
         - Enters search query
-        - System searches through all recipes in CSV file
-        - Displays matching recipes in a list
+        - Searches are answered from an inverted index (RecipeIndex) with
+          bitmap operations. The index is opened from the segment files kept
+          by RecipeIndexStore, so recipes.csv is only read to (re)build it
+          when the files are missing or stale
+        - Query search accepts boolean expressions (see RecipeQuery), e.g.
+          ingredient:garlic AND NOT ingredient:peanut AND name:soup AND id:100..200
+        - Instructions are not indexed; instructions searches (and
+          instructions: query terms) run a ParallelScan over a catalog copy
+          that is only loaded the first time such a search is made. The same
+          copy feeds the similar-recipe index, built when a recipe is viewed
+        - Searches return lightweight handles (SearchHit: id + score), not
+          recipe copies; results are rendered one page (PAGE_SIZE rows) at a
+          time using names from the index
+        - The full recipe is only fetched (Recipe::findById) when viewed
+        - Indexes and an LRU result cache are shared by every SearchRecipePage
+          and keyed by Recipe::tableVersion(), so repeated searches within a
+          session are served without touching recipes.csv, and any save or
+          delete makes older entries unreachable
         - User can view a recipe by entering its number
-        - Options: View Recipe, Delete Recipe, Research (search again), List All, or Back
+        - Options: View Recipe, Delete Recipe, Next Page, Previous Page,
+          Research (search again), List All, or Back
 
     Header classes:
     #include "../../vendor/sys/out.h"
     #include "../../vendor/base/page.h"
+    #include "../../vendor/sys/lru.h"
     #include "recipe.cpp"
+    #include "recipeindex.cpp"
+    #include "indexstore.cpp"
+    #include "recipequery.cpp"
+    #include "similarrecipes.cpp"
+    #include "parallelscan.cpp"
     #include "viewrecipe.cpp"
 
     SearchRecipePage:
         private:
-            - searchResults         : Vector of recipes matching search query
+            - SearchHit             : Result handle (recipe id + score)
+            - PAGE_SIZE             : Results rendered per page
+            - searchResults         : Handles of recipes matching search query
+            - currentPage           : Zero-based page being displayed
             - lastSearchQuery       : Stores the last search query string
-            - lastSearchType        : Stores the last search type (1=name, 2=ingredients, 3=id)
+            - lastSearchType        : Stores the last search type (1=name, 2=ingredients, 3=id, 4=all, 5=query, 6=instructions)
+            - lastQueryPlan         : Compiled plan of the last query search
+            - CachedSearch          : Cached hits and plan for one search
+            - index                 : Inverted index over catalog (shared)
+            - similarity            : MinHash/LSH index for similar recipes (shared, lazy)
+            - indexVersion          : Recipe table version the index was attached at
+            - indexGeneration       : Store generation the index was attached at
+            - similarityVersion     : Recipe table version of the similarity index
+            - resultCache           : LRU of (type, normalized query, version) -> results (shared)
+            - scanCatalog           : Full recipes for unindexed scans (shared, lazy)
+            - scanVersion           : Recipe table version of scanCatalog
+            - loadCatalog()         : Attaches the stored index, rebuilding it when stale
+            - loadScanCatalog()     : Loads recipes for scans when stale
+            - loadSimilarity()      : Builds the similar-recipe index when stale
+            - scanInstructions()    : Parallel scan for an instructions substring
+            - normalizeQuery()      : Trim, lowercase and collapse whitespace
+            - runSearch()           : Serves a search from cache or evaluates it
+            - collectResults()      : Converts a bitmap of ids into result handles
+            - pageCount()           : Number of result pages
+            - nextPage() / prevPage(): Page navigation
             - performSearch()       : Executes search based on type and query
             - searchByName()        : Searches recipes by name
             - searchByIngredients() : Searches recipes by ingredients
             - searchById()          : Finds a recipe by its numeric id
+            - searchByQuery()       : Evaluates a boolean query
+            - searchByInstructions(): Scans recipe instructions
             - listAll()             : Loads all recipes into the results list
-            - displayResults()      : Shows search results list
+            - listAllCached()       : List all through the result cache
+            - displayResults()      : Shows the current page of results
             - viewRecipeByNumber()  : Opens recipe modal by list number
             - deleteRecipeByNumber(): Deletes recipe from list by number
         protected:
@@ -47,69 +102,232 @@
 */
 class SearchRecipePage : public Page {
 private:
-    vector<Recipe> searchResults;                                           // stores matching recipes
+    struct SearchHit {
+        int id;                                                             // recipe id
+        double score;                                                       // relevance (1.0 for boolean matches)
+    };
+
+    static constexpr int PAGE_SIZE = 10;                                    // results per page
+
+    vector<SearchHit> searchResults;                                        // handles of matching recipes
+    int currentPage = 0;                                                    // zero-based page index
     string lastSearchQuery;                                                 // last search query
-    int lastSearchType;                                                     // last search type (1=name, 2=ingredients)
+    int lastSearchType;                                                     // last search type (1=name, 2=ingredients, 3=id, 4=all, 5=query, 6=instructions)
+    string lastQueryPlan;                                                   // compiled plan of last query
+    bool lastSearchFailed = false;                                          // last query did not parse
+
+    struct CachedSearch {
+        vector<SearchHit> hits;                                             // matching handles
+        string plan;                                                        // compiled plan (queries only)
+    };
+
+    static inline RecipeIndex index;                                        // inverted index over catalog
+    static inline RecipeSimilarity similarity;                              // similar-recipe index
+    static inline bool indexBuilt = false;                                  // index is attached
+    static inline unsigned long long indexVersion = 0;                      // table version at attach
+    static inline unsigned long long indexGeneration = 0;                   // store generation at attach
+    static inline bool similarityBuilt = false;                             // similarity holds a catalog
+    static inline unsigned long long similarityVersion = 0;                 // table version of similarity
+    static inline LRUCache<string, CachedSearch> resultCache{64};           // recent search results
+    static inline vector<Recipe> scanCatalog;                               // recipes for unindexed scans
+    static inline bool scanLoaded = false;                                  // scanCatalog holds a catalog
+    static inline unsigned long long scanVersion = 0;                       // table version of scanCatalog
 
     /*
-        Search recipes by name
+        Attach the stored index segments (rebuild only when they are stale)
     */
-    void searchByName(string query) {
-        vector<Recipe> allRecipes = Recipe::loadAll();                      // load all recipes from CSV
-        searchResults.clear();                                              // clear previous results
-        string lowerQuery = out.toLowerCase(query);                         // convert query to lowercase
+    void loadCatalog() {
+        RecipeIndexStore& store = RecipeIndexStore::shared();
+        store.poll();                                                       // install finished merges
+        if (indexBuilt && indexVersion == Recipe::tableVersion() && indexGeneration == store.generation()) {
+            return;                                                         // index is current
+        }
+        if (!store.isCurrent()) {                                           // missing, stale or edited outside
+            vector<Recipe> catalog = Recipe::loadAll();                     // single read of recipes.csv
+            store.rebuild(catalog);                                         // write a fresh segment
+        }
+        index.attach(store.view());                                         // mapped segments, no parsing
+        indexVersion = Recipe::tableVersion();
+        indexGeneration = store.generation();
+        indexBuilt = true;
+    }
 
-        for (int i = 0; i < allRecipes.size(); i++) {                       // loop through all recipes
-            string lowerName = out.toLowerCase(allRecipes[i].name);         // convert recipe name to lowercase
-            if (lowerName.find(lowerQuery) != string::npos) {               // check if query is in name
-                searchResults.push_back(allRecipes[i]);                     // add to results
-            }
+    /*
+        Build the similar-recipe index (only when the table changed)
+    */
+    void loadSimilarity() {
+        if (similarityBuilt && similarityVersion == Recipe::tableVersion()) { return; }
+        loadScanCatalog();                                                  // shares the scan catalog
+        similarity.build(scanCatalog);                                      // build MinHash buckets
+        similarityVersion = scanVersion;
+        similarityBuilt = true;
+    }
+
+    /*
+        Load recipes for unindexed scans (only when the table changed)
+    */
+    void loadScanCatalog() {
+        if (scanLoaded && scanVersion == Recipe::tableVersion()) { return; }    // catalog is current
+        scanCatalog = Recipe::loadAll();                                    // kept only once a scan is used
+        scanVersion = Recipe::tableVersion();
+        scanLoaded = true;
+    }
+
+    /*
+        Ids of recipes whose instructions contain the text (parallel scan)
+    */
+    Bitmap scanInstructions(string text) {
+        loadScanCatalog();                                                  // ensure scan catalog is loaded
+        return ParallelScan::run(scanCatalog, ParallelScan::instructionsContain(text));
+    }
+
+    /*
+        Normalize query text for cache keys
+    */
+    string normalizeQuery(string query) {
+        string lower = out.toLowerCase(out.trim(query));
+        string result = "";
+        bool space = false;
+        for (char c : lower) {
+            if (c == ' ' || c == '\t') { space = true; continue; }          // collapse whitespace runs
+            if (space && !result.empty()) { result += ' '; }
+            space = false;
+            result += c;
         }
+        return result;
     }
 
     /*
-        Search recipes by ingredients
+        Serve a search from the result cache, or run it and cache the result
     */
-    void searchByIngredients(string query) {
-        vector<Recipe> allRecipes = Recipe::loadAll();                      // load all recipes from CSV
+    void runSearch(int type, string query) {
+        string key = to_string(type) + "|" + normalizeQuery(query) + "|" + to_string(Recipe::tableVersion());
+        CachedSearch cached;
+        if (resultCache.get(key, cached)) {                                 // cache hit
+            searchResults = cached.hits;
+            lastQueryPlan = cached.plan;
+            currentPage = 0;
+            return;
+        }
+
+        lastSearchFailed = false;
+        if (type == 1) { searchByName(query); }                             // dispatch by search type
+        else if (type == 2) { searchByIngredients(query); }
+        else if (type == 3) { searchById(stoi(query)); }
+        else if (type == 4) { listAll(); }
+        else if (type == 6) { searchByInstructions(query); }
+        else { searchByQuery(query); }
+
+        if (lastSearchFailed) { return; }                                   // do not cache errors
+        cached.hits = searchResults;
+        cached.plan = lastQueryPlan;
+        resultCache.put(key, cached);                                       // key reflects pre-search version
+    }
+
+    /*
+        Convert matching ids into result handles (ascending id order)
+    */
+    void collectResults(Bitmap matches) {
         searchResults.clear();                                              // clear previous results
-        string lowerQuery = out.toLowerCase(query);                         // convert query to lowercase
-
-        for (int i = 0; i < allRecipes.size(); i++) {                       // loop through all recipes
-            bool found = false;                                             // flag for ingredient match
-            for (int j = 0; j < allRecipes[i].ingredients.size(); j++) {    // loop through ingredients
-                string lowerIngredient = out.toLowerCase(allRecipes[i].ingredients[j]);  // convert to lowercase
-                if (lowerIngredient.find(lowerQuery) != string::npos) {     // check if query is in ingredient
-                    found = true;                                           // mark as found
-                    break;                                                  // stop searching this recipe
-                }
-            }
-            if (found) {                                                    // if ingredient matched
-                searchResults.push_back(allRecipes[i]);                     // add to results
-            }
+        currentPage = 0;                                                    // start at first page
+        vector<uint32_t> ids = matches.toVector();
+        searchResults.reserve(ids.size());
+        for (int i = 0; i < ids.size(); i++) {
+            SearchHit hit;
+            hit.id = int(ids[i]);
+            hit.score = 1.0;
+            searchResults.push_back(hit);                                   // add handle only
         }
     }
 
+    /*
+        Number of result pages
+    */
+    int pageCount() {
+        return (int(searchResults.size()) + PAGE_SIZE - 1) / PAGE_SIZE;
+    }
+
+    /*
+        Move to the next / previous page of results
+    */
+    void nextPage() {
+        if (currentPage + 1 < pageCount()) { currentPage++; }               // advance if possible
+        else { out.coutln("Already on the last page."); out.br(); }
+    }
+
+    void prevPage() {
+        if (currentPage > 0) { currentPage--; }                             // go back if possible
+        else { out.coutln("Already on the first page."); out.br(); }
+    }
+
+    /*
+        Search recipes by name
+    */
+    void searchByName(string query) {
+        loadCatalog();                                                      // ensure index is built
+        collectResults(index.matchName(query));                             // lookup name postings
+    }
+
+    /*
+        Search recipes by ingredients
+    */
+    void searchByIngredients(string query) {
+        loadCatalog();                                                      // ensure index is built
+        collectResults(index.matchIngredient(query));                       // lookup ingredient postings
+    }
+
     /*
         List all recipes (no filtering)
     */
     void listAll() {
-        searchResults = Recipe::loadAll();                                  // load all recipes
+        loadCatalog();                                                      // ensure catalog is loaded
+        collectResults(index.all);                                          // every recipe id
+    }
+
+    /*
+        List all recipes through the result cache
+    */
+    void listAllCached() {
+        runSearch(4, "");                                                   // cached list-all
         lastSearchQuery = "all";                                           // mark query as all
+        lastQueryPlan = "";
     }
 
     /*
         Search recipe by numeric id (matches Recipe.id)
     */
     void searchById(int id) {
-        vector<Recipe> allRecipes = Recipe::loadAll();                      // load all recipes from CSV
-        searchResults.clear();                                              // clear previous results
-        for (int i = 0; i < allRecipes.size(); i++) {                       // iterate all recipes
-            if (allRecipes[i].id == id) {                                   // match on id
-                searchResults.push_back(allRecipes[i]);                     // add match
-                break;                                                      // stop after first match
-            }
+        loadCatalog();                                                      // ensure index is built
+        collectResults(index.matchIdRange(id, id));                         // single id lookup
+    }
+
+    /*
+        Search recipes with a boolean query
+    */
+    void searchByQuery(string query) {
+        loadCatalog();                                                      // ensure index is built
+        RecipeQuery q;
+        if (!q.parse(query)) {                                              // invalid query
+            searchResults.clear();
+            currentPage = 0;
+            lastQueryPlan = "";
+            lastSearchFailed = true;
+            out.coutln("Query error: " + q.error);                          // show parse error
+            out.br();
+            return;
         }
+        lastQueryPlan = q.describe();                                       // remember plan for display
+        collectResults(q.evaluate(index, [this](string text) {              // run bitmap plan
+            return scanInstructions(text);                                  // unindexed terms are scanned
+        }));
+    }
+
+    /*
+        Search recipes by a substring of their instructions
+    */
+    void searchByInstructions(string query) {
+        loadCatalog();                                                      // index supplies result names
+        collectResults(scanInstructions(query));                            // no index: parallel scan
     }
 
     /*
@@ -124,23 +342,32 @@ private:
         out.coutln("2. Ingredients");                                       // option 2
         out.coutln("3. ID");                                                // option 3 (by id)
         out.coutln("4. List All");                                          // option 4 (list all)
-        out.coutln("5. Cancel");
+        out.coutln("5. Query (e.g. ingredient:garlic AND NOT name:soup)");  // option 5 (boolean query)
+        out.coutln("6. Instructions");                                      // option 6 (full scan)
+        out.coutln("7. Cancel");
         out.br();                                                           // blank line
         lastSearchType = out.inputi("Enter your choice: ");                 // get search type
         out.br();                                                           // blank line
+        lastQueryPlan = "";                                                 // plan only shown for queries
 
         if (lastSearchType == 1) {                                          // search by name
             lastSearchQuery = out.inputs("Enter recipe name: ");            // get search query
-            searchByName(lastSearchQuery);                                  // perform name search
+            runSearch(1, lastSearchQuery);                                  // perform name search
         } else if (lastSearchType == 2) {                                   // search by ingredients
             lastSearchQuery = out.inputs("Enter ingredient: ");             // get search query
-            searchByIngredients(lastSearchQuery);                           // perform ingredient search
+            runSearch(2, lastSearchQuery);                                  // perform ingredient search
         } else if (lastSearchType == 3) {                                   // search by id
             int id = out.inputi("Enter recipe id (number): ");             // get id to search
-            searchById(id);                                                 // perform id search
+            runSearch(3, to_string(id));                                    // perform id search
             lastSearchQuery = "id=" + to_string(id);                        // record query text
         } else if (lastSearchType == 4) {                                   // list all
-            listAll();                                                      // load all recipes into results
+            listAllCached();                                                // load all recipes into results
+        } else if (lastSearchType == 5) {                                   // boolean query
+            lastSearchQuery = out.inputs("Enter query: ");                  // get query text
+            runSearch(5, lastSearchQuery);                                  // evaluate query plan
+        } else if (lastSearchType == 6) {                                   // search instructions
+            lastSearchQuery = out.inputs("Enter text in instructions: ");   // get search text
+            runSearch(6, lastSearchQuery);                                  // perform parallel scan
         } else {                                                            // invalid choice
             out.coutln("Invalid choice!");                                  // error message
             out.br();                                                       // blank line
@@ -149,7 +376,7 @@ private:
     }
 
     /*
-        Display search results
+        Display the current page of search results
     */
     void displayResults() {
         out.br();                                                           // blank line
@@ -160,9 +387,18 @@ private:
             out.coutln("No recipes found matching your search.");           // show message
         } else {                                                            // results found
             out.coutln("Search Results (" + to_string(searchResults.size()) + " recipe(s) found):");  // show count
+            if (!lastQueryPlan.empty()) {
+                out.coutln("Plan: " + lastQueryPlan);                       // show compiled query plan
+            }
             out.br();                                                       // blank line
-            for (int i = 0; i < searchResults.size(); i++) {                // loop through results
-                out.coutln(to_string(i + 1) + ". " + searchResults[i].name);  // display recipe name
+            int start = currentPage * PAGE_SIZE;                            // first row on page
+            int end = min(start + PAGE_SIZE, int(searchResults.size()));    // one past last row
+            for (int i = start; i < end; i++) {                             // render only this page
+                out.coutln(to_string(i + 1) + ". " + index.nameOf(searchResults[i].id));  // display recipe name
+            }
+            if (pageCount() > 1) {
+                out.br();
+                out.coutln("Page " + to_string(currentPage + 1) + " of " + to_string(pageCount()));
             }
         }
     }
@@ -181,8 +417,14 @@ private:
         int choice = out.inputi("Which recipe? (Enter number): ");          // get recipe number
         
         if (choice > 0 && choice <= searchResults.size()) {                 // valid choice
-            ViewRecipeModal viewModal(searchResults[choice - 1]);           // create modal with recipe
-            viewModal.init();                                               // show recipe modal
+            Recipe recipe = Recipe::findById(searchResults[choice - 1].id); // materialize selected recipe only
+            if (recipe.id == 0) {                                           // removed since search
+                out.coutln("Recipe no longer exists.");
+                out.br();
+                return;
+            }
+            loadSimilarity();                                               // built on first view
+            Navigator::shared().open(new ViewRecipeModal(recipe, &similarity));    // show recipe modal next
         } else {                                                            // invalid choice
             out.coutln("Invalid recipe number!");                           // error message
             out.br();                                                       // blank line
@@ -203,10 +445,9 @@ private:
         int choice = out.inputi("Which recipe to delete? (Enter number): ");  // get recipe number
         
         if (choice > 0 && choice <= searchResults.size()) {                 // valid choice
-            Recipe recipeToDelete = searchResults[choice - 1];              // get selected recipe
-            DeleteRecipeModal deleteModal(recipeToDelete.id);               // create modal with recipe id
-            deleteModal.init();                                             // show delete modal
-            performSearch();                                                // refresh search results after deletion
+            Navigator::shared().open(new DeleteRecipeModal(searchResults[choice - 1].id), [this]() {
+                performSearch();                                            // refresh search results after deletion
+            });                                                             // show delete modal (bumps table version)
         } else {                                                            // invalid choice
             out.coutln("Invalid recipe number!");                           // error message
             out.br();                                                       // blank line
@@ -243,11 +484,17 @@ public:
             Options("Delete Recipe", [this]() {
                 deleteRecipeByNumber();                                     // delete selected recipe
             }),
+            Options("Next Page", [this]() {
+                nextPage();                                                 // show next page of results
+            }),
+            Options("Previous Page", [this]() {
+                prevPage();                                                 // show previous page of results
+            }),
             Options("Research", [this]() {
                 performSearch();                                            // perform new search
             }),
             Options("List All", [this]() {
-                listAll();                                                  // load all recipes
+                listAllCached();                                            // load all recipes
             })
         };
     }
@@ -0,0 +1,193 @@
+#ifndef SIMILARRECIPES_H
+#define SIMILARRECIPES_H
+
+#include "../../vendor/sys/out.h"
+#include "recipe.cpp"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+/*
+    RecipeSimilarity Struct
+
+    Finds "recipes like this one" by ingredient overlap (Jaccard similarity)
+    without comparing every pair of recipes.
+
+    How it works:
+        - Each recipe's ingredient names are lowercased and hashed into a
+          sorted set of 64-bit values.
+        - A MinHash signature of HASHES values is computed per recipe; the
+          chance two signatures agree at a position equals their Jaccard
+          similarity.
+        - The signature is cut into BANDS bands of ROWS values. Every band is
+          hashed into a bucket (locality-sensitive hashing); recipes sharing
+          any bucket become candidates. With 16 x 4 the candidate threshold
+          sits around 0.5 similarity.
+        - Candidates are re-ranked by exact Jaccard on the hashed sets, so
+          a lookup costs a few bucket reads plus a small sort.
+        - Oversized buckets are capped at BUCKET_SCAN entries per lookup to
+          keep latency flat on very large catalogs.
+
+    Header classes:
+    #include "../../vendor/sys/out.h"
+    #include "recipe.cpp"
+
+    RecipeSimilarity:
+        private:
+            - ids / names               : Recipe id and name per row
+            - sets                      : Sorted ingredient hashes per row
+            - signatures                : Flattened MinHash signatures (rows x HASHES)
+            - buckets                   : Band hash -> rows, one map per band
+            - rowById                   : Recipe id -> row
+            - hashString(text)          : FNV-1a string hash (static)
+            - mix(x)                    : splitmix64 finalizer (static)
+            - jaccard(a, b)             : Exact similarity of two sorted sets (static)
+        public:
+            - Match                     : Similar recipe (id, name, score)
+            - build(recipes)            : Compute signatures and LSH buckets
+            - topSimilar(id, k)         : Best k matches for a recipe id
+*/
+struct RecipeSimilarity {
+public:
+    struct Match {
+        int id;
+        string name;
+        double score;                                                       // Jaccard similarity 0..1
+    };
+
+private:
+    static constexpr int BANDS = 16;                                        // LSH bands
+    static constexpr int ROWS = 4;                                          // signature values per band
+    static constexpr int HASHES = BANDS * ROWS;                             // signature length
+    static constexpr int BUCKET_SCAN = 2000;                                // max rows read per bucket
+
+    vector<int> ids;                                                        // row -> recipe id
+    vector<string> names;                                                   // row -> recipe name
+    vector<vector<uint64_t>> sets;                                          // row -> sorted ingredient hashes
+    vector<uint32_t> signatures;                                            // row-major MinHash values
+    vector<unordered_map<uint64_t, vector<int>>> buckets;                   // band -> bucket -> rows
+    unordered_map<int, int> rowById;                                        // recipe id -> row
+
+    static uint64_t hashString(string text) {
+        uint64_t h = 1469598103934665603ULL;                                // FNV offset basis
+        for (char c : text) {
+            h ^= uint64_t(static_cast<unsigned char>(c));
+            h *= 1099511628211ULL;                                          // FNV prime
+        }
+        return h;
+    }
+
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;                                         // splitmix64 finalizer
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    static double jaccard(const vector<uint64_t>& a, const vector<uint64_t>& b) {
+        if (a.empty() && b.empty()) return 0.0;
+        size_t i = 0; size_t j = 0; size_t common = 0;
+        while (i < a.size() && j < b.size()) {                              // sorted intersection
+            if (a[i] == b[j]) { common++; i++; j++; }
+            else if (a[i] < b[j]) { i++; }
+            else { j++; }
+        }
+        return double(common) / double(a.size() + b.size() - common);
+    }
+
+    uint64_t bandHash(int row, int band) {
+        uint64_t h = uint64_t(band) * 0x9E3779B97F4A7C15ULL;
+        for (int r = 0; r < ROWS; r++) {
+            h = mix(h ^ signatures[size_t(row) * HASHES + band * ROWS + r]);    // fold band values
+        }
+        return h;
+    }
+
+public:
+    /*
+        Compute signatures and LSH buckets for the catalog
+    */
+    void build(vector<Recipe>& recipes) {
+        ids.clear(); names.clear(); sets.clear(); signatures.clear(); rowById.clear();
+        buckets.assign(BANDS, unordered_map<uint64_t, vector<int>>());
+        ids.reserve(recipes.size()); names.reserve(recipes.size()); sets.reserve(recipes.size());
+        signatures.reserve(recipes.size() * HASHES);
+
+        for (int i = 0; i < recipes.size(); i++) {
+            if (recipes[i].id <= 0) { continue; }                           // skip rows without id
+            vector<uint64_t> set;
+            for (int j = 0; j < recipes[i].ingredients.size(); j++) {
+                string iname = ""; string iamount = ""; string iunit = "";
+                Recipe::splitIngredient(recipes[i].ingredients[j], iname, iamount, iunit);
+                iname = out.toLowerCase(iname);
+                if (!iname.empty()) { set.push_back(hashString(iname)); }
+            }
+            sort(set.begin(), set.end());
+            set.erase(unique(set.begin(), set.end()), set.end());          // distinct ingredients
+
+            int row = int(ids.size());
+            ids.push_back(recipes[i].id);
+            names.push_back(recipes[i].name);
+            rowById[recipes[i].id] = row;
+
+            for (int h = 0; h < HASHES; h++) {                              // MinHash per seed
+                uint64_t seed = mix(uint64_t(h + 1));
+                uint32_t best = 0xFFFFFFFFu;
+                for (uint64_t v : set) {
+                    uint32_t hv = uint32_t(mix(v ^ seed) >> 32);
+                    if (hv < best) best = hv;
+                }
+                signatures.push_back(best);
+            }
+            sets.push_back(set);
+
+            if (set.empty()) { continue; }                                  // nothing to compare on
+            for (int b = 0; b < BANDS; b++) {
+                buckets[b][bandHash(row, b)].push_back(row);                // register band bucket
+            }
+        }
+    }
+
+    /*
+        Best k similar recipes for a recipe id (excluding itself)
+    */
+    vector<Match> topSimilar(int id, int k) {
+        vector<Match> result;
+        auto found = rowById.find(id);
+        if (found == rowById.end() || buckets.empty()) { return result; }  // unknown recipe
+        int row = found->second;
+        if (sets[row].empty()) { return result; }
+
+        unordered_set<int> seen;
+        seen.insert(row);
+        for (int b = 0; b < BANDS; b++) {                                   // gather candidates
+            auto bucket = buckets[b].find(bandHash(row, b));
+            if (bucket == buckets[b].end()) { continue; }
+            const vector<int>& rows = bucket->second;
+            int limit = min(int(rows.size()), BUCKET_SCAN);
+            for (int i = 0; i < limit; i++) {
+                if (seen.insert(rows[i]).second) {
+                    Match m;
+                    m.id = ids[rows[i]];
+                    m.name = names[rows[i]];
+                    m.score = jaccard(sets[row], sets[rows[i]]);            // exact re-rank
+                    result.push_back(m);
+                }
+            }
+        }
+
+        sort(result.begin(), result.end(), [](const Match& a, const Match& b) {
+            if (a.score != b.score) return a.score > b.score;               // most similar first
+            return a.id < b.id;
+        });
+        if (result.size() > k) { result.resize(k); }
+        return result;
+    }
+};
+
+#endif // SIMILARRECIPES_H
@@ -1,7 +1,10 @@
 #include "../../vendor/sys/out.h"
+#include "../../vendor/sys/units.h"
 #include "../../vendor/base/modal.h"
 #include "recipe.cpp"
+#include "similarrecipes.cpp"
 #include "../pantrymanager/pantry.cpp"
+#include "../pantrymanager/pantrybatch.cpp"
 #include "../grocerymanager/grocery.cpp"
 
 /*
@@ -13,24 +16,51 @@
     How it works:
         - Takes a Recipe object in the constructor
         - Displays the recipe preview in a formatted box
+        - When a RecipeSimilarity index is supplied, lists the most similar
+          recipes by ingredient overlap (for substitutions)
+        - Offers to generate grocery entries for missing ingredients and to
+          cook the recipe, which takes its ingredients out of the pantry in
+          one PantryBatch (dated lots are used first-expired-first-out)
         - Automatically returns to parent page after user presses Enter
 
     Header classes:
     #include "../../vendor/sys/out.h"
+    #include "../../vendor/sys/units.h"
     #include "../../vendor/base/modal.h"
     #include "recipe.cpp"
+    #include "similarrecipes.cpp"
+    #include "../pantrymanager/pantrybatch.cpp"
 
     ViewRecipeModal:
         private:
             - recipe                : Recipe object to display
+            - similarity            : Optional similarity index (nullptr to skip)
+            - displaySimilar()      : Lists the top similar recipes
+            - cookRecipe()          : Deducts the recipe's ingredients from the pantry
         protected:
             - schema()              : Main modal logic (override from Modal)
         public:
-            - ViewRecipeModal()     : Constructor that takes a Recipe object
+            - ViewRecipeModal()     : Constructor that takes a Recipe object and optional similarity index
 */
 class ViewRecipeModal : public Modal {
 private:
     Recipe recipe;                                                          // recipe to display
+    RecipeSimilarity* similarity;                                           // similar-recipe index (optional)
+
+    /*
+        Show the top similar recipes by ingredient overlap
+    */
+    void displaySimilar() {
+        if (similarity == nullptr) { return; }                              // no index supplied
+        vector<RecipeSimilarity::Match> matches = similarity->topSimilar(recipe.id, 5);
+        if (matches.size() == 0) { return; }                                // nothing similar enough
+        out.coutln("Similar recipes:");
+        for (int i = 0; i < matches.size(); i++) {
+            int percent = int(matches[i].score * 100.0 + 0.5);              // similarity as percent
+            out.coutln("- " + matches[i].name + " (ID: " + to_string(matches[i].id) + ", " + to_string(percent) + "% match)");
+        }
+        out.br();
+    }
 
     /*
         Parse ingredient token into name, amount, and unit
@@ -64,22 +94,17 @@ private:
             - Returns found status
     */
     bool findInPantry(string itemName, double& quantity, string& unit) {
-        vector<Pantry> pantry = Pantry::loadAll();              // load all pantry items
-        string nameLower = out.toLowerCase(itemName);           // normalize search name
-        for (int i = 0; i < pantry.size(); i++) {               // search pantry
-            if (out.toLowerCase(pantry[i].name) == nameLower) { // name match
-                unit = pantry[i].unit;                          // get unit
-                try { quantity = stod(pantry[i].quantity); } catch (...) { quantity = 0.0; }    // parse quantity
-                return true;                                    // found
-            }
-        }
-        return false;                                           // not found
+        Pantry item = Pantry::findByName(itemName);             // indexed, case-insensitive lookup
+        if (item.id == 0) return false;                         // not found
+        unit = item.unit;                                       // get unit
+        quantity = item.quantity;                               // already numeric
+        return true;                                            // found
     }
 
     /*
         Add item to grocery list with given quantity
     */
-    void addToGrocery(string name, string quantity, string unit) {
+    void addToGrocery(string name, double quantity, string unit) {
         GroceryItem item(name, quantity, unit);                 // create grocery item
         item.save();                                            // save to list
     }
@@ -95,45 +120,80 @@ private:
             parseIngredient(recipe.ingredients[i], name, amountStr, unit);  // parse ingredient
 
             double need = 0.0;
-            if (amountStr != "") {                              // amount provided
-                try { need = stod(amountStr); } catch (...) { need = 0.0; }     // parse amount
-            }
+            if (!out.parseNumber(amountStr, need)) need = 0.0;  // parse amount (0 when unknown)
+            double fallback = need > 0.0 ? need : 1.0;          // default to 1 if unknown
 
             double have = 0.0; string pantryUnit = "";
             bool inPantry = findInPantry(name, have, pantryUnit);   // check pantry
 
+            double missing = 0.0;
             if (!inPantry) {                                    // not in pantry
-                string qty = amountStr == "" ? "1" : amountStr; // default to 1 if unknown
-                addToGrocery(name, qty, unit);                  // add full amount
-            } else if (unit != "" && pantryUnit != "" && unit != pantryUnit) {  // unit mismatch
-                string qty = amountStr == "" ? "1" : amountStr; // default to 1 if unknown
-                addToGrocery(name, qty, unit);                  // add full amount (no conversion)
-            } else if (need == 0.0 && have <= 0.0) {            // unknown amount and pantry empty
-                addToGrocery(name, "1", unit);                  // add default 1
-            } else if (need > have) {                           // need more than available
-                double diff = need - have;                      // calculate shortage
-                addToGrocery(name, to_string(diff), unit);      // add difference
+                addToGrocery(name, fallback, unit);             // add full amount
+            } else if (need == 0.0) {                           // unknown amount
+                if (have <= 0.0) addToGrocery(name, 1.0, unit); // pantry empty: add default 1
+            } else if (!Units::shortfall(need, unit, have, pantryUnit, name, missing)) {   // units not convertible
+                addToGrocery(name, fallback, unit);             // add full amount
+            } else if (missing > 0.0) {                         // need more than available
+                addToGrocery(name, missing, unit);              // add difference (recipe unit)
             }
         }
         out.coutln("Grocery list generated based on pantry availability.");
         out.br();
     }
 
+    /*
+        Cook the recipe - deduct ingredients from the pantry
+            - One PantryBatch, so pantry.csv and its lots are written once
+            - Ingredients with unknown amounts, missing from the pantry or
+              in units that cannot be converted are left untouched
+    */
+    void cookRecipe() {
+        PantryBatch batch;                                      // one pantry transaction
+        int untouched = 0;
+        for (int i = 0; i < recipe.ingredients.size(); i++) {   // process each ingredient
+            string name = ""; string amountStr = ""; string unit = "";
+            parseIngredient(recipe.ingredients[i], name, amountStr, unit);  // parse ingredient
+
+            double need = 0.0; double have = 0.0; double converted = 0.0; string pantryUnit = "";
+            if (!out.parseNumber(amountStr, need) || need <= 0.0 || !findInPantry(name, have, pantryUnit)
+                || !Units::convert(need, unit, pantryUnit, name, converted)) {
+                untouched++;                                    // nothing safe to deduct
+                continue;
+            }
+            batch.subtract(name, need, unit);                   // converted on commit
+        }
+        if (!batch.commit()) {                                  // single write
+            out.coutln("Error: Could not update pantry.");
+            out.br();
+            return;
+        }
+        out.coutln("Used " + to_string(batch.updated) + " ingredient(s) from the pantry.");
+        if (!batch.lotsSaved) out.coutln("Warning: Could not update expiry lots.");
+        if (untouched > 0) {
+            out.coutln(to_string(untouched) + " ingredient(s) were not deducted (missing, no amount, or incompatible units).");
+        }
+        out.br();
+    }
+
 protected:
     /*
         Main modal schema - Display recipe details
     */
     void schema() override {
         recipe.displayPreview();                                            // show recipe in formatted box
+        displaySimilar();                                                   // suggest substitutions
         bool gen = out.inputYesNo("Generate grocery list for missing ingredients? (y/n): ");  // prompt for grocery generation
         if (gen) { generateGroceryForRecipe(); }    // generate grocery list if confirmed
+        bool cook = out.inputYesNo("Cook this recipe now (use ingredients from pantry)? (y/n): ");   // prompt for cooking
+        if (cook) { cookRecipe(); }                 // deduct ingredients if confirmed
     }
 
 public:
     /*
         Constructor - Initialize with recipe to display
     */
-    ViewRecipeModal(Recipe r) {
+    ViewRecipeModal(Recipe r, RecipeSimilarity* sim = nullptr) {
         recipe = r;                                                         // store recipe to display
+        similarity = sim;                                                   // store similarity index
     }
 };